@@ -0,0 +1,102 @@
+/**
+ * @file columns_bench.c
+ * @brief Multi-column sort against qsort over row structs.
+ *
+ * Usage: columns_bench [max_rows]   (default 10M)
+ *
+ * An orders table sorted by (region u8, day u16, amount i32) with a
+ * uint64_t order id payload. Region and day are low cardinality, so the
+ * amount column decides most of the order.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "overflow_columns.h"
+#include "overflow_dataset.h"
+
+#define DEFAULT_MAX 10000000
+
+typedef struct {
+  uint8_t region;
+  uint16_t day;
+  int32_t amount;
+  uint64_t id;
+} Order;
+
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int cmp_order(const void *pa, const void *pb) {
+  const Order *a = pa, *b = pb;
+  if (a->region != b->region)
+    return a->region < b->region ? -1 : 1;
+  if (a->day != b->day)
+    return a->day < b->day ? -1 : 1;
+  if (a->amount != b->amount)
+    return a->amount < b->amount ? -1 : 1;
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  size_t max_n = argc > 1 ? strtoull(argv[1], NULL, 10) : DEFAULT_MAX;
+  overflow_rng rng;
+
+  printf("%12s %14s %14s %8s\n", "rows", "columns (s)", "qsort (s)",
+         "speedup");
+  for (size_t n = 1000; n <= max_n; n *= 10) {
+    uint8_t *region = malloc(n);
+    uint16_t *day = malloc(sizeof(uint16_t) * n);
+    int32_t *amount = malloc(sizeof(int32_t) * n);
+    uint64_t *id = malloc(sizeof(uint64_t) * n);
+    Order *rows = malloc(sizeof(Order) * n);
+
+    overflow_rng_seed(&rng, 36);
+    for (size_t i = 0; i < n; ++i) {
+      uint64_t r = overflow_rng_next(&rng);
+      rows[i].region = region[i] = r % 16;
+      rows[i].day = day[i] = (r >> 8) % 366;
+      rows[i].amount = amount[i] = (int32_t)(r >> 32) % 100000;
+      rows[i].id = id[i] = i;
+    }
+
+    overflow_column keys[] = {
+        {region, 1, 0}, {day, 2, 0}, {amount, 4, OVERFLOW_COL_SIGNED}};
+    overflow_column payload[] = {{id, 8, 0}};
+
+    double t0 = now_sec();
+    overflow_sort_columns(keys, 3, payload, 1, n);
+    double t_columns = now_sec() - t0;
+
+    t0 = now_sec();
+    qsort(rows, n, sizeof(Order), cmp_order);
+    double t_qsort = now_sec() - t0;
+
+    for (size_t i = 0; i < n; ++i) {
+      if (region[i] != rows[i].region || day[i] != rows[i].day ||
+          amount[i] != rows[i].amount) {
+        printf("Mismatch at row %zu\n", i);
+        return 1;
+      }
+    }
+    printf("%12zu %14.6f %14.6f %7.2fx\n", n, t_columns, t_qsort,
+           t_qsort / t_columns);
+
+    free(region);
+    free(day);
+    free(amount);
+    free(id);
+    free(rows);
+  }
+  return 0;
+}
@@ -0,0 +1,85 @@
+/**
+ * @file cpp_sort_bench.cpp
+ * @brief overflow::sort<T>() against the C engine and std::sort.
+ *
+ * Usage: cpp_sort_bench [keys]   (default 10M)
+ *
+ * The uint32_t rows must match the C engine; the template instantiations
+ * are expected to be no slower. Wider and signed keys are timed against
+ * std::sort only.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "overflow.hpp"
+
+extern "C" {
+#include "overflow_engine.h"
+#include "overflow_parallel.h"
+}
+
+#define DEFAULT_SIZE 10000000
+
+static double now_sec() {
+  using clock = std::chrono::steady_clock;
+  return std::chrono::duration<double>(clock::now().time_since_epoch())
+      .count();
+}
+
+template <class K, class Fn>
+static void run(const char *name, const std::vector<K> &input, Fn sort) {
+  std::vector<K> keys = input;
+  double start = now_sec();
+  sort(keys);
+  double elapsed = now_sec() - start;
+
+  if (!std::is_sorted(keys.begin(), keys.end()))
+    std::printf("%s: output not sorted\n", name);
+  std::printf("%s,%.6f\n", name, elapsed);
+}
+
+int main(int argc, char **argv) {
+  std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : DEFAULT_SIZE;
+  std::mt19937_64 rng(42);
+
+  std::vector<std::uint32_t> u32(n);
+  std::vector<std::int64_t> i64(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    std::uint64_t r = rng();
+    u32[i] = std::uint32_t(r);
+    i64[i] = std::int64_t(r) >> (r % 40);
+  }
+
+  std::printf("Sorting %zu keys\n", n);
+  std::printf("variant,seconds\n");
+
+  // Both sides allocate their scratch per call
+  run("C overflow_sort_u32", u32,
+      [](auto &v) { overflow_sort_u32(v.data(), v.size()); });
+  run("C overflow_sort_parallel_u32", u32, [](auto &v) {
+    std::vector<std::uint32_t> scratch(v.size());
+    overflow_sort_parallel_u32(v.data(), v.size(), scratch.data(), 0);
+  });
+  run("overflow::sort<uint32_t>", u32, [](auto &v) { overflow::sort(v); });
+  run("overflow::sort(par, uint32_t)", u32,
+      [](auto &v) { overflow::sort(overflow::par, v); });
+  run("std::sort<uint32_t>", u32,
+      [](auto &v) { std::sort(v.begin(), v.end()); });
+
+  run("overflow::sort<int64_t>", i64, [](auto &v) { overflow::sort(v); });
+  run("overflow::sort(par, int64_t)", i64,
+      [](auto &v) { overflow::sort(overflow::par, v); });
+  run("std::sort<int64_t>", i64,
+      [](auto &v) { std::sort(v.begin(), v.end()); });
+  return 0;
+}
@@ -0,0 +1,113 @@
+/**
+ * @file dataset_bench.c
+ * @brief Dataset generation speed and cache reload time.
+ *
+ * Usage: dataset_bench [keys] [cache_dir]   (default 100M, no cache)
+ *
+ * The rand()/log/sqrt/cos baseline is generate_realworld_value() from
+ * sort_scaling_benchmark.c. With a cache directory each distribution is
+ * loaded twice: the first load generates and writes the file, the second
+ * only maps it (pages are faulted in by a checksum pass in both cases).
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "overflow_dataset.h"
+#include "overflow_parallel.h"
+
+#define DEFAULT_SIZE 100000000
+
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+uint16_t generate_realworld_value() {
+  double u1 = ((double)rand() + 1.0) / ((double)RAND_MAX + 2.0);
+  double u2 = ((double)rand() + 1.0) / ((double)RAND_MAX + 2.0);
+  double z = sqrt(-2.0 * log(u1)) * cos(2 * M_PI * u2);
+  double val = 128 + z * 40;
+  if (val < 0)
+    val = 0;
+  if (val > 255)
+    val = 255;
+  return (uint16_t)val;
+}
+
+static uint64_t checksum(const uint32_t *keys, size_t n) {
+  uint64_t sum = 0;
+  for (size_t i = 0; i < n; ++i)
+    sum += keys[i];
+  return sum;
+}
+
+int main(int argc, char **argv) {
+  size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : DEFAULT_SIZE;
+  const char *dir = argc > 2 ? argv[2] : "";
+  const char *names[] = {"uniform", "normal", "lognormal", "zipf"};
+  overflow_dataset_spec specs[] = {
+      {.dist = OVERFLOW_DIST_UNIFORM, .seed = 42},
+      {.dist = OVERFLOW_DIST_NORMAL, .seed = 42, .a = 128, .b = 40,
+       .range = 256},
+      {.dist = OVERFLOW_DIST_LOGNORMAL, .seed = 42, .a = 10, .b = 2},
+      {.dist = OVERFLOW_DIST_ZIPF, .seed = 42, .a = 1.1, .range = 1000000},
+  };
+
+  uint32_t *keys = malloc(sizeof(uint32_t) * n);
+  if (!keys) {
+    fprintf(stderr, "Memory allocation failed\n");
+    return 1;
+  }
+
+  printf("Generating %zu keys, %u threads\n", n, overflow_parallel_threads());
+  printf("variant,seconds,Mkeys/s\n");
+
+  srand(42);
+  double start = now_sec();
+  for (size_t i = 0; i < n; ++i)
+    keys[i] = generate_realworld_value();
+  double t = now_sec() - start;
+  printf("rand() realworld,%.6f,%.1f\n", t, n / t * 1e-6);
+
+  for (int d = 0; d < 4; ++d) {
+    start = now_sec();
+    overflow_dataset_generate(keys, n, &specs[d], 1);
+    t = now_sec() - start;
+    printf("%s 1 thread,%.6f,%.1f\n", names[d], t, n / t * 1e-6);
+
+    start = now_sec();
+    overflow_dataset_generate(keys, n, &specs[d], 0);
+    t = now_sec() - start;
+    printf("%s all threads,%.6f,%.1f\n", names[d], t, n / t * 1e-6);
+  }
+  free(keys);
+
+  if (!*dir)
+    return 0;
+  for (int d = 0; d < 4; ++d) {
+    for (int pass = 0; pass < 2; ++pass) {
+      start = now_sec();
+      uint32_t *mapped = overflow_dataset_load(dir, n, &specs[d], 0);
+      if (!mapped) {
+        fprintf(stderr, "Dataset load failed\n");
+        return 1;
+      }
+      uint64_t sum = checksum(mapped, n);
+      t = now_sec() - start;
+      printf("%s %s,%.6f,%.1f (sum %llu)\n", names[d],
+             pass ? "cached load" : "first load", t, n / t * 1e-6,
+             (unsigned long long)sum);
+      overflow_dataset_release(mapped, n);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,154 @@
+/**
+ * @file heap_bench.cpp
+ * @brief Dijkstra with the radix heaps against std::priority_queue.
+ *
+ * Usage: heap_bench [vertices] [degree]   (default 1M and 8)
+ *
+ * Builds a random directed graph with uniform edge weights and runs
+ * single-source shortest paths with lazy deletion (stale entries are
+ * popped and skipped), so every queue sees the same push and pop
+ * sequence. Weights up to 2^8 and 2^20 show short and long key spans.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+extern "C" {
+#include "overflow_heap.h"
+}
+
+struct Graph {
+  std::vector<uint32_t> first; // Edges of v are [first[v], first[v + 1])
+  std::vector<uint32_t> to, weight;
+};
+
+static double now_sec() {
+  using clock = std::chrono::steady_clock;
+  return std::chrono::duration<double>(clock::now().time_since_epoch())
+      .count();
+}
+
+static Graph random_graph(uint32_t vertices, uint32_t degree,
+                          uint32_t max_weight, uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  Graph g;
+  g.first.resize(vertices + 1);
+  g.to.resize((size_t)vertices * degree);
+  g.weight.resize(g.to.size());
+  for (uint32_t v = 0; v <= vertices; ++v)
+    g.first[v] = v * degree;
+  for (size_t e = 0; e < g.to.size(); ++e) {
+    g.to[e] = (uint32_t)(rng() % vertices);
+    g.weight[e] = 1 + (uint32_t)(rng() % max_weight);
+  }
+  return g;
+}
+
+// Runs Dijkstra from vertex 0; Queue wraps push(dist, v) / pop(dist, v).
+template <class Dist, class Queue>
+static std::vector<Dist> dijkstra(const Graph &g, Queue &q, size_t &pops) {
+  std::vector<Dist> dist(g.first.size() - 1, ~Dist(0));
+  dist[0] = 0;
+  q.push(0, 0);
+  pops = 0;
+
+  Dist d;
+  uint32_t v;
+  while (q.pop(d, v)) {
+    pops++;
+    if (d != dist[v])
+      continue;
+    for (uint32_t e = g.first[v]; e < g.first[v + 1]; ++e) {
+      Dist nd = d + g.weight[e];
+      if (nd < dist[g.to[e]]) {
+        dist[g.to[e]] = nd;
+        q.push(nd, g.to[e]);
+      }
+    }
+  }
+  return dist;
+}
+
+struct StdQueue {
+  using Entry = std::pair<uint64_t, uint32_t>;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> q;
+
+  void push(uint64_t d, uint32_t v) { q.emplace(d, v); }
+  bool pop(uint64_t &d, uint32_t &v) {
+    if (q.empty())
+      return false;
+    d = q.top().first;
+    v = q.top().second;
+    q.pop();
+    return true;
+  }
+};
+
+struct Radix32 {
+  overflow_radix_heap_u32 *h = overflow_radix_heap_create_u32();
+  ~Radix32() { overflow_radix_heap_destroy_u32(h); }
+
+  void push(uint32_t d, uint32_t v) { overflow_radix_heap_push_u32(h, d, v); }
+  bool pop(uint32_t &d, uint32_t &v) {
+    return overflow_radix_heap_pop_u32(h, &d, &v) == 0;
+  }
+};
+
+struct Radix64 {
+  overflow_radix_heap_u64 *h = overflow_radix_heap_create_u64();
+  ~Radix64() { overflow_radix_heap_destroy_u64(h); }
+
+  void push(uint64_t d, uint32_t v) { overflow_radix_heap_push_u64(h, d, v); }
+  bool pop(uint64_t &d, uint32_t &v) {
+    return overflow_radix_heap_pop_u64(h, &d, &v) == 0;
+  }
+};
+
+template <class Dist, class Queue>
+static void run(const char *name, const Graph &g,
+                const std::vector<uint64_t> &want) {
+  Queue q;
+  size_t pops;
+  double start = now_sec();
+  std::vector<Dist> dist = dijkstra<Dist>(g, q, pops);
+  double elapsed = now_sec() - start;
+
+  for (size_t v = 0; v < dist.size(); ++v)
+    if (want[v] != ~uint64_t(0) ? dist[v] != want[v] : dist[v] != ~Dist(0)) {
+      std::printf("%s: wrong distance at vertex %zu\n", name, v);
+      break;
+    }
+  std::printf("%s,%.6f,%.1f\n", name, elapsed, pops / elapsed / 1e6);
+}
+
+int main(int argc, char **argv) {
+  uint32_t vertices = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 10) : 1000000;
+  uint32_t degree = argc > 2 ? (uint32_t)strtoul(argv[2], NULL, 10) : 8;
+  static const uint32_t max_weights[] = {1u << 8, 1u << 20};
+
+  std::printf("queue,seconds,mpops_per_sec\n");
+  for (uint32_t max_weight : max_weights) {
+    Graph g = random_graph(vertices, degree, max_weight, 45);
+    StdQueue ref;
+    size_t pops;
+    std::vector<uint64_t> want = dijkstra<uint64_t>(g, ref, pops);
+
+    std::printf("# %u vertices, degree %u, weights 1..%u, %zu pops\n",
+                vertices, degree, max_weight, pops);
+    run<uint64_t, StdQueue>("std::priority_queue", g, want);
+    run<uint32_t, Radix32>("radix_heap_u32", g, want);
+    run<uint64_t, Radix64>("radix_heap_u64", g, want);
+  }
+  return 0;
+}
@@ -0,0 +1,81 @@
+/**
+ * @file hugepage_bench.c
+ * @brief Large-array sort with 4 KiB vs 2 MiB scratch pages.
+ *
+ * Usage: hugepage_bench [keys]   (default 100M)
+ *
+ * Each mode sorts the same data twice with one context: the first call pays
+ * for arena allocation and prefaulting, the second shows steady state.
+ * MAP_HUGETLB needs pages reserved in /proc/sys/vm/nr_hugepages and silently
+ * falls back to transparent huge pages otherwise. Set OVERFLOW_DATASET_DIR
+ * to reuse the input across runs.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "overflow_ctx.h"
+#include "overflow_dataset.h"
+
+#define DEFAULT_SIZE 100000000
+
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char **argv) {
+  size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : DEFAULT_SIZE;
+  const char *names[] = {"4 KiB pages", "THP (madvise)", "MAP_HUGETLB"};
+  int modes[] = {OVERFLOW_PAGES_SMALL, OVERFLOW_PAGES_HUGE,
+                 OVERFLOW_PAGES_HUGETLB};
+
+  overflow_dataset_spec spec = {.dist = OVERFLOW_DIST_UNIFORM, .seed = 42};
+  uint32_t *input = overflow_dataset_load(NULL, n, &spec, 0);
+  uint32_t *keys = malloc(sizeof(uint32_t) * n);
+  if (!input || !keys) {
+    fprintf(stderr, "Memory allocation failed\n");
+    return 1;
+  }
+
+  printf("Sorting %zu keys, %u threads\n", n, overflow_parallel_threads());
+  printf("mode,first_call_s,steady_s\n");
+
+  for (int m = 0; m < 3; ++m) {
+    overflow_sort_ctx ctx;
+    overflow_ctx_init(&ctx);
+    ctx.threads = 0;
+    ctx.pages = modes[m];
+
+    memcpy(keys, input, sizeof(uint32_t) * n);
+    double start = now_sec();
+    overflow_sort_ctx_u32(&ctx, keys, n);
+    double first = now_sec() - start;
+
+    memcpy(keys, input, sizeof(uint32_t) * n);
+    start = now_sec();
+    overflow_sort_ctx_u32(&ctx, keys, n);
+    double steady = now_sec() - start;
+
+    for (size_t i = 1; i < n; ++i) {
+      if (keys[i - 1] > keys[i]) {
+        printf("%s: output not sorted at %zu\n", names[m], i);
+        break;
+      }
+    }
+    printf("%s,%.6f,%.6f\n", names[m], first, steady);
+    overflow_ctx_free(&ctx);
+  }
+
+  overflow_dataset_release(input, n);
+  free(keys);
+  return 0;
+}
@@ -0,0 +1,92 @@
+/**
+ * @file iter_bench.c
+ * @brief Cost of reading the first k sorted keys: lazy iterator vs full sort.
+ *
+ * Usage: iter_bench [keys]   (default 10M)
+ *
+ * Each row times creating an overflow_sorted_iter and reading k keys,
+ * against copying the input and running overflow_sort_u32() on all of it.
+ * The "page" rows skip to the middle and read 50 keys.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "overflow_dataset.h"
+#include "overflow_engine.h"
+#include "overflow_iter.h"
+
+#define DEFAULT_SIZE 10000000
+
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Reads k keys after skipping `skip`; returns seconds, or -1 on a mismatch.
+static double lazy(const uint32_t *input, size_t n, size_t skip, size_t k,
+                   const uint32_t *sorted, uint32_t *out) {
+  double start = now_sec();
+  overflow_sorted_iter *it = overflow_sorted_iter_create(input, n);
+  if (!it)
+    return -1;
+  overflow_sorted_iter_skip(it, skip);
+  size_t got = 0, len;
+  while (got < k && (len = overflow_sorted_iter_next(it, out + got, k - got)))
+    got += len;
+  double t = now_sec() - start;
+  overflow_sorted_iter_destroy(it);
+  return memcmp(out, &sorted[skip], got * sizeof(uint32_t)) ? -1 : t;
+}
+
+int main(int argc, char **argv) {
+  size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : DEFAULT_SIZE;
+  const char *names[] = {"uniform", "lognormal"};
+  overflow_dataset_spec specs[] = {
+      {.dist = OVERFLOW_DIST_UNIFORM, .seed = 42},
+      {.dist = OVERFLOW_DIST_LOGNORMAL, .seed = 42, .a = 10, .b = 2},
+  };
+  size_t ks[] = {50, 1000, 100000, n};
+
+  uint32_t *input = malloc(sizeof(uint32_t) * n);
+  uint32_t *sorted = malloc(sizeof(uint32_t) * n);
+  uint32_t *out = malloc(sizeof(uint32_t) * n);
+  if (!input || !sorted || !out) {
+    fprintf(stderr, "Memory allocation failed\n");
+    return 1;
+  }
+
+  printf("Reading sorted prefixes of %zu keys\n", n);
+  printf("variant,seconds\n");
+  for (int d = 0; d < 2; ++d) {
+    overflow_dataset_generate(input, n, &specs[d], 0);
+
+    double start = now_sec();
+    memcpy(sorted, input, sizeof(uint32_t) * n);
+    overflow_sort_u32(sorted, n);
+    printf("%s full sort,%.6f\n", names[d], now_sec() - start);
+
+    for (size_t i = 0; i < sizeof(ks) / sizeof(ks[0]); ++i) {
+      double t = lazy(input, n, 0, ks[i], sorted, out);
+      if (t < 0)
+        printf("%s first %zu: output mismatch\n", names[d], ks[i]);
+      else
+        printf("%s iter first %zu,%.6f\n", names[d], ks[i], t);
+    }
+    double t = lazy(input, n, n / 2, 50, sorted, out);
+    printf("%s iter page at n/2,%.6f\n", names[d], t);
+  }
+
+  free(input);
+  free(sorted);
+  free(out);
+  return 0;
+}
@@ -0,0 +1,177 @@
+/**
+ * @file join_bench.cpp
+ * @brief overflow_join_u32() against a hash join and a qsort sort-merge.
+ *
+ * Usage: join_bench [fact rows] [threads]   (default 10M, all CPUs)
+ *
+ * The hash join builds a chained, linear-probed table on the right column
+ * and probes it with the left one, the usual plan for a fact-dimension
+ * join. The qsort baseline sorts row indices of both columns by key and
+ * merges them. All three must agree on the pair count and on an
+ * order-independent checksum of the pairs.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+extern "C" {
+#include "overflow_join.h"
+}
+
+#define DEFAULT_SIZE 10000000
+#define EMPTY UINT32_MAX
+
+struct Result {
+  size_t pairs;
+  uint64_t checksum;
+};
+
+static double now_sec() {
+  using clock = std::chrono::steady_clock;
+  return std::chrono::duration<double>(clock::now().time_since_epoch())
+      .count();
+}
+
+static void add_pair(Result &r, uint32_t l, uint32_t rr) {
+  r.pairs++;
+  r.checksum += (uint64_t)l * 0x9E3779B1u ^ rr;
+}
+
+static Result hash_join(const std::vector<uint32_t> &left,
+                        const std::vector<uint32_t> &right, unsigned mode) {
+  size_t slots = 2;
+  while (slots < 2 * right.size())
+    slots *= 2;
+  std::vector<uint32_t> key(slots), head(slots, EMPTY), next(right.size());
+
+  // Built back to front, so each chain lists its rows in ascending order
+  for (size_t i = right.size(); i-- > 0;) {
+    size_t h = (right[i] * 0x9E3779B1u) & (slots - 1);
+    while (head[h] != EMPTY && key[h] != right[i])
+      h = (h + 1) & (slots - 1);
+    key[h] = right[i];
+    next[i] = head[h];
+    head[h] = (uint32_t)i;
+  }
+
+  Result r = {0, 0};
+  for (size_t i = 0; i < left.size(); ++i) {
+    size_t h = (left[i] * 0x9E3779B1u) & (slots - 1);
+    while (head[h] != EMPTY && key[h] != left[i])
+      h = (h + 1) & (slots - 1);
+    for (uint32_t j = head[h]; j != EMPTY; j = next[j]) {
+      add_pair(r, (uint32_t)i, j);
+      if (mode == OVERFLOW_JOIN_SEMI)
+        break;
+    }
+  }
+  return r;
+}
+
+static const uint32_t *qsort_keys;
+
+static int cmp_row(const void *a, const void *b) {
+  uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+  if (qsort_keys[x] != qsort_keys[y])
+    return qsort_keys[x] < qsort_keys[y] ? -1 : 1;
+  return (x > y) - (x < y);
+}
+
+static std::vector<uint32_t> qsort_rows(const std::vector<uint32_t> &keys) {
+  std::vector<uint32_t> rows(keys.size());
+  for (size_t i = 0; i < rows.size(); ++i)
+    rows[i] = (uint32_t)i;
+  qsort_keys = keys.data();
+  qsort(rows.data(), rows.size(), sizeof(uint32_t), cmp_row);
+  return rows;
+}
+
+static Result qsort_join(const std::vector<uint32_t> &left,
+                         const std::vector<uint32_t> &right, unsigned mode) {
+  std::vector<uint32_t> l = qsort_rows(left), r = qsort_rows(right);
+  Result res = {0, 0};
+  size_t j = 0;
+  for (size_t i = 0; i < l.size(); ++i) {
+    uint32_t key = left[l[i]];
+    while (j < r.size() && right[r[j]] < key)
+      j++;
+    for (size_t k = j; k < r.size() && right[r[k]] == key; ++k) {
+      add_pair(res, l[i], r[k]);
+      if (mode == OVERFLOW_JOIN_SEMI)
+        break;
+    }
+  }
+  return res;
+}
+
+static Result overflow_join(const std::vector<uint32_t> &left,
+                            const std::vector<uint32_t> &right, unsigned mode,
+                            unsigned threads) {
+  overflow_join_pair *pairs;
+  size_t n;
+  Result r = {0, 0};
+  if (overflow_join_u32(left.data(), left.size(), right.data(), right.size(),
+                        mode, threads, &pairs, &n) != 0) {
+    std::printf("overflow_join_u32 failed\n");
+    return r;
+  }
+  for (size_t i = 0; i < n; ++i)
+    add_pair(r, pairs[i].left, pairs[i].right);
+  free(pairs);
+  return r;
+}
+
+static void run_case(const char *name, const std::vector<uint32_t> &left,
+                     const std::vector<uint32_t> &right, unsigned mode,
+                     unsigned threads) {
+  double t0 = now_sec();
+  Result h = hash_join(left, right, mode);
+  double t1 = now_sec();
+  Result q = qsort_join(left, right, mode);
+  double t2 = now_sec();
+  Result o = overflow_join(left, right, mode, threads);
+  double t3 = now_sec();
+
+  if (h.pairs != o.pairs || h.checksum != o.checksum ||
+      q.pairs != o.pairs || q.checksum != o.checksum)
+    std::printf("%s: results differ\n", name);
+  std::printf("%s,%zu,%.6f,%.6f,%.6f\n", name, o.pairs, t1 - t0, t2 - t1,
+              t3 - t2);
+}
+
+int main(int argc, char **argv) {
+  size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : DEFAULT_SIZE;
+  unsigned threads = argc > 2 ? (unsigned)strtoul(argv[2], NULL, 10) : 0;
+  std::mt19937 rng(46);
+
+  // Dimension of n / 10 distinct random keys; every fact row hits one
+  std::vector<uint32_t> dim(n / 10), fact(n), probe(n);
+  for (auto &k : dim)
+    k = rng();
+  for (auto &k : fact)
+    k = dim[rng() % dim.size()];
+  // Half the probe rows miss the dimension
+  for (auto &k : probe)
+    k = rng() % 2 ? dim[rng() % dim.size()] : rng();
+  // Many-to-many: n / 5 rows each side over n / 50 values
+  std::vector<uint32_t> many_l(n / 5), many_r(n / 5);
+  for (auto &k : many_l)
+    k = 1000000 + rng() % (uint32_t)(n / 50);
+  for (auto &k : many_r)
+    k = 1000000 + rng() % (uint32_t)(n / 50);
+
+  std::printf("case,pairs,hash_s,qsort_s,overflow_s\n");
+  run_case("fact-dim inner", fact, dim, OVERFLOW_JOIN_INNER, threads);
+  run_case("half-miss semi", probe, dim, OVERFLOW_JOIN_SEMI, threads);
+  run_case("many-many inner", many_l, many_r, OVERFLOW_JOIN_INNER, threads);
+  run_case("many-many semi", many_l, many_r, OVERFLOW_JOIN_SEMI, threads);
+  return 0;
+}
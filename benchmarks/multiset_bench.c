@@ -0,0 +1,120 @@
+/**
+ * @file multiset_bench.c
+ * @brief Update and query throughput of the ordered multiset.
+ *
+ * Usage: multiset_bench [keys]   (default 2M)
+ *
+ * Inserts the keys in batches of 1, 64 and 4096, then times rank, select
+ * and batched erase. The baseline is the insert_sorted() approach from
+ * experiments/overflow_sort_simple_iterative.c (binary search plus memmove
+ * into one sorted array), capped at 200K keys because it is O(n) per key.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "overflow_dataset.h"
+#include "overflow_multiset.h"
+
+#define DEFAULT_SIZE 2000000
+#define BASELINE_MAX 200000
+
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void report(const char *name, size_t ops, double t) {
+  printf("%s,%.6f,%.2f\n", name, t, ops / t * 1e-6);
+}
+
+static void sorted_array_insert(uint32_t *a, size_t n, uint32_t key) {
+  size_t lo = 0, hi = n;
+  while (lo < hi) {
+    size_t mid = (lo + hi) / 2;
+    if (a[mid] <= key)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  memmove(&a[lo + 1], &a[lo], (n - lo) * sizeof(uint32_t));
+  a[lo] = key;
+}
+
+int main(int argc, char **argv) {
+  size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : DEFAULT_SIZE;
+  overflow_dataset_spec spec = {.dist = OVERFLOW_DIST_UNIFORM, .seed = 42};
+  size_t batches[] = {1, 64, 4096};
+  char name[64];
+
+  uint32_t *keys = malloc(sizeof(uint32_t) * n);
+  uint32_t *array = malloc(sizeof(uint32_t) * BASELINE_MAX);
+  if (!keys || !array) {
+    fprintf(stderr, "Memory allocation failed\n");
+    return 1;
+  }
+  overflow_dataset_generate(keys, n, &spec, 0);
+
+  printf("Multiset of %zu keys\n", n);
+  printf("variant,seconds,Mops/s\n");
+
+  size_t base_n = n < BASELINE_MAX ? n : BASELINE_MAX;
+  double start = now_sec();
+  for (size_t i = 0; i < base_n; ++i)
+    sorted_array_insert(array, i, keys[i]);
+  snprintf(name, sizeof(name), "sorted array insert (%zu keys)", base_n);
+  report(name, base_n, now_sec() - start);
+
+  overflow_multiset *ms = NULL;
+  for (size_t b = 0; b < sizeof(batches) / sizeof(batches[0]); ++b) {
+    overflow_multiset_destroy(ms);
+    ms = overflow_multiset_create();
+    start = now_sec();
+    for (size_t i = 0; i < n; i += batches[b]) {
+      size_t len = n - i < batches[b] ? n - i : batches[b];
+      if (overflow_multiset_insert(ms, &keys[i], len) != 0) {
+        fprintf(stderr, "Insert failed\n");
+        return 1;
+      }
+    }
+    snprintf(name, sizeof(name), "insert batch %zu", batches[b]);
+    report(name, n, now_sec() - start);
+  }
+
+  uint64_t sum = 0;
+  start = now_sec();
+  for (size_t i = 0; i < n; ++i)
+    sum += overflow_multiset_rank(ms, keys[i] ^ 0x5555);
+  report("rank", n, now_sec() - start);
+
+  start = now_sec();
+  for (size_t i = 0; i < n; ++i) {
+    uint32_t key;
+    overflow_multiset_select(ms, (size_t)keys[i] % n, &key);
+    sum += key;
+  }
+  report("select", n, now_sec() - start);
+
+  start = now_sec();
+  for (size_t i = 0; i < n; i += 64) {
+    size_t len = n - i < 64 ? n - i : 64;
+    overflow_multiset_erase(ms, &keys[i], len, NULL);
+  }
+  report("erase batch 64", n, now_sec() - start);
+  if (overflow_multiset_size(ms) != 0)
+    printf("erase left %zu keys\n", overflow_multiset_size(ms));
+
+  printf("(checksum %llu)\n", (unsigned long long)sum);
+  overflow_multiset_destroy(ms);
+  free(keys);
+  free(array);
+  return 0;
+}
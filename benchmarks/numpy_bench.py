@@ -0,0 +1,46 @@
+"""
+overflow_np.sort / argsort against numpy.
+
+Usage: make python && PYTHONPATH=build:python python3 benchmarks/numpy_bench.py [n]
+
+Both sides sort a fresh copy in place (ndarray.sort), so only the sort is
+timed. argsort is compared with np.argsort(kind="stable"), which is what
+overflow_np.argsort returns.
+"""
+
+import sys
+import time
+
+import numpy as np
+
+import overflow_np
+
+n = int(sys.argv[1]) if len(sys.argv) > 1 else 10_000_000
+rng = np.random.default_rng(42)
+
+
+def best_of(fn, keys, rounds=3):
+    best = float("inf")
+    for _ in range(rounds):
+        a = keys.copy()
+        start = time.perf_counter()
+        fn(a)
+        best = min(best, time.perf_counter() - start)
+    return best
+
+
+print(f"Sorting {n} keys")
+print("dtype,numpy_sort_s,overflow_sort_s,numpy_argsort_s,overflow_argsort_s")
+for dtype in [np.uint8, np.uint16, np.uint32, np.uint64, np.int32, np.int64,
+              np.float32, np.float64]:
+    if np.issubdtype(dtype, np.floating):
+        keys = rng.standard_normal(n).astype(dtype)
+    else:
+        keys = rng.integers(0, np.iinfo(dtype).max, n, dtype=dtype)
+
+    t_np = best_of(lambda a: a.sort(), keys)
+    t_ov = best_of(overflow_np.sort, keys)
+    t_np_arg = best_of(lambda a: np.argsort(a, kind="stable"), keys, 1)
+    t_ov_arg = best_of(overflow_np.argsort, keys, 1)
+    print(f"{np.dtype(dtype).name},{t_np:.6f},{t_ov:.6f},"
+          f"{t_np_arg:.6f},{t_ov_arg:.6f}")
@@ -0,0 +1,78 @@
+/**
+ * @file partition_bench.c
+ * @brief Magnitude-class partitioning against a full sort.
+ *
+ * Usage: partition_bench [keys] [threads]   (default 20M, all CPUs)
+ *
+ * Times overflow_partition_log2() by tick alone, with 4 sub-classes per
+ * octave and writing row indices, next to a full overflow_sort_u32() of a
+ * copy. The partition is the sort's first pass without the refinement.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "overflow_dataset.h"
+#include "overflow_engine.h"
+#include "overflow_partition.h"
+
+#define DEFAULT_SIZE 20000000
+
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char **argv) {
+  size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : DEFAULT_SIZE;
+  unsigned threads = argc > 2 ? (unsigned)strtoul(argv[2], NULL, 10) : 0;
+  const char *names[] = {"uniform", "lognormal"};
+  overflow_dataset_spec specs[] = {
+      {.dist = OVERFLOW_DIST_UNIFORM, .seed = 47},
+      {.dist = OVERFLOW_DIST_LOGNORMAL, .seed = 47, .a = 10, .b = 2},
+  };
+  static size_t offsets[OVERFLOW_PARTITION_CLASSES(2) + 1];
+
+  uint32_t *input = malloc(sizeof(uint32_t) * n);
+  uint32_t *out = malloc(sizeof(uint32_t) * n);
+  if (!input || !out) {
+    fprintf(stderr, "Memory allocation failed\n");
+    return 1;
+  }
+
+  printf("Grouping %zu keys by magnitude class\n", n);
+  printf("variant,seconds\n");
+  for (int d = 0; d < 2; ++d) {
+    overflow_dataset_generate(input, n, &specs[d], 0);
+
+    double start = now_sec();
+    memcpy(out, input, sizeof(uint32_t) * n);
+    overflow_sort_u32(out, n);
+    printf("%s full sort,%.6f\n", names[d], now_sec() - start);
+
+    start = now_sec();
+    overflow_partition_log2(input, n, 0, 0, threads, out, offsets);
+    printf("%s by tick,%.6f\n", names[d], now_sec() - start);
+
+    start = now_sec();
+    overflow_partition_log2(input, n, 2, 0, threads, out, offsets);
+    printf("%s 4 per octave,%.6f\n", names[d], now_sec() - start);
+
+    start = now_sec();
+    overflow_partition_log2(input, n, 2, OVERFLOW_PARTITION_INDICES, threads,
+                            out, offsets);
+    printf("%s 4 per octave indices,%.6f\n", names[d], now_sec() - start);
+  }
+
+  free(input);
+  free(out);
+  return 0;
+}
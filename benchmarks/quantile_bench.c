@@ -0,0 +1,76 @@
+/**
+ * @file quantile_bench.c
+ * @brief Log-linear quantiles against sorting a copy and indexing it.
+ *
+ * Usage: quantile_bench [keys]   (default 10M)
+ *
+ * p50/p99/p999 of lognormal "latencies", estimated for several sub_bits
+ * settings and then refined to exact keys, next to overflow_sort_u32() on
+ * a copy. The error column is the worst relative error of the estimates.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "overflow_dataset.h"
+#include "overflow_engine.h"
+#include "overflow_quantile.h"
+
+#define DEFAULT_N 10000000
+
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char **argv) {
+  size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : DEFAULT_N;
+  const double q[] = {0.5, 0.99, 0.999};
+  overflow_dataset_spec spec = {OVERFLOW_DIST_LOGNORMAL, 40, 9.0, 1.5, 0};
+  uint32_t *keys = overflow_dataset_load(NULL, n, &spec, 0);
+  uint32_t *copy = malloc(sizeof(uint32_t) * n);
+  uint32_t exact[3], got[3];
+
+  double t0 = now_sec();
+  memcpy(copy, keys, sizeof(uint32_t) * n);
+  overflow_sort_u32(copy, n);
+  for (int i = 0; i < 3; ++i)
+    exact[i] = copy[(size_t)(q[i] * (double)(n - 1) + 0.5)];
+  double t_sort = now_sec() - t0;
+
+  printf("%zu lognormal keys: p50 %u  p99 %u  p999 %u\n", n, exact[0],
+         exact[1], exact[2]);
+  printf("%-18s %10s %10s %10s\n", "method", "time (s)", "speedup",
+         "max error");
+  printf("%-18s %10.4f %10s %10s\n", "sort copy", t_sort, "1.00x", "0");
+
+  unsigned subs[] = {3, 7, 10};
+  for (int m = 0; m < 3; ++m) {
+    for (unsigned flags = 0; flags <= OVERFLOW_QUANTILE_EXACT; ++flags) {
+      t0 = now_sec();
+      overflow_quantiles(keys, n, q, 3, subs[m], flags, got);
+      double t = now_sec() - t0;
+      double worst = 0;
+      for (int i = 0; i < 3; ++i) {
+        double e = ((double)got[i] - exact[i]) / exact[i];
+        worst = e < 0 ? -e > worst ? -e : worst : e > worst ? e : worst;
+      }
+      char name[32];
+      snprintf(name, sizeof(name), "sub_bits=%u%s", subs[m],
+               flags ? " exact" : "");
+      printf("%-18s %10.4f %9.2fx %10.2e\n", name, t, t_sort / t, worst);
+    }
+  }
+
+  overflow_dataset_release(keys, n);
+  free(copy);
+  return 0;
+}
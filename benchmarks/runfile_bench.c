@@ -0,0 +1,169 @@
+/**
+ * @file runfile_bench.c
+ * @brief Run file lookups against binary search over the same mapped keys.
+ *
+ * Usage: runfile_bench [keys] [dir]   (default 100M, /tmp)
+ *
+ * Each dataset is written as a run file once. Both methods then answer the
+ * same lower-bound queries (half of them keys that are present) from a
+ * freshly mapped copy of that file: the directory lookup of
+ * overflow_runfile_lower_bound(), and a branch-free binary search over
+ * the whole key array. Each method first runs COLD_QUERIES queries with
+ * the file dropped from the page cache, reporting the key pages each
+ * query reads in (mincore) and its latency; the throughput passes then
+ * run with every key page mapped.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "overflow_dataset.h"
+#include "overflow_runfile.h"
+
+#define DEFAULT_SIZE 100000000
+#define QUERIES 4000000
+#define COLD_QUERIES 2000
+
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Writes back and evicts the file's cached pages.
+static void drop_cache(const char *path) {
+  int fd = open(path, O_RDONLY);
+  if (fd < 0)
+    return;
+  fsync(fd);
+  posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+  close(fd);
+}
+
+// Pages of keys[0..n) resident in memory.
+static size_t resident_pages(const uint32_t *keys, size_t n) {
+  size_t page = (size_t)sysconf(_SC_PAGESIZE);
+  uintptr_t lo = (uintptr_t)keys & ~(page - 1);
+  size_t len = (uintptr_t)(keys + n) - lo, count = 0;
+  unsigned char *vec = malloc((len + page - 1) / page);
+  if (!vec || mincore((void *)lo, len, vec) != 0) {
+    free(vec);
+    return 0;
+  }
+  for (size_t i = 0; i < (len + page - 1) / page; ++i)
+    count += vec[i] & 1;
+  free(vec);
+  return count;
+}
+
+static size_t binary_search(const uint32_t *keys, size_t n, uint32_t key) {
+  const uint32_t *p = keys;
+  size_t len = n;
+  if (n == 0)
+    return 0;
+  while (len > 1) {
+    size_t half = len / 2;
+    p = p[half] < key ? p + half : p;
+    len -= half;
+  }
+  return (size_t)(p - keys) + (*p < key);
+}
+
+typedef struct {
+  double warm_s, cold_us, cold_pages;
+} Result;
+
+// Runs queries[0..count) with one method on a fresh, uncached mapping of
+// path; the first COLD_QUERIES also run cold, one at a time.
+static Result run(const char *path, const uint32_t *queries, size_t count,
+                  int directory, size_t *checksum) {
+  Result r;
+  drop_cache(path);
+  overflow_runfile *rf = overflow_runfile_open(path);
+  const uint32_t *keys = overflow_runfile_keys(rf);
+  size_t n = overflow_runfile_size(rf), sum = 0;
+
+  size_t before = resident_pages(keys, n);
+  double start = now_sec();
+  for (size_t i = 0; i < COLD_QUERIES; ++i)
+    sum += directory ? overflow_runfile_lower_bound(rf, queries[i])
+                     : binary_search(keys, n, queries[i]);
+  r.cold_us = (now_sec() - start) * 1e6 / COLD_QUERIES;
+  r.cold_pages =
+      (double)(resident_pages(keys, n) - before) / COLD_QUERIES;
+
+  // Fault the rest of the keys in so the timed pass measures lookups only
+  for (size_t i = 0; i < n; i += 1024)
+    sum += keys[i];
+  start = now_sec();
+  for (size_t i = 0; i < count; ++i)
+    sum += directory ? overflow_runfile_lower_bound(rf, queries[i])
+                     : binary_search(keys, n, queries[i]);
+  r.warm_s = now_sec() - start;
+  *checksum = sum;
+  overflow_runfile_close(rf);
+  return r;
+}
+
+int main(int argc, char **argv) {
+  size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : DEFAULT_SIZE;
+  const char *dir = argc > 2 ? argv[2] : "/tmp";
+  const char *names[] = {"uniform", "lognormal", "zipf"};
+  overflow_dataset_spec specs[] = {
+      {.dist = OVERFLOW_DIST_UNIFORM, .seed = 50},
+      {.dist = OVERFLOW_DIST_LOGNORMAL, .seed = 50, .a = 16, .b = 2},
+      {.dist = OVERFLOW_DIST_ZIPF, .seed = 50, .a = 1.1, .range = 1u << 24},
+  };
+  char path[4096];
+
+  uint32_t *keys = malloc(sizeof(uint32_t) * n);
+  uint32_t *queries = malloc(sizeof(uint32_t) * QUERIES);
+  if (!keys || !queries) {
+    fprintf(stderr, "Memory allocation failed\n");
+    return 1;
+  }
+  snprintf(path, sizeof(path), "%s/overflow_runfile_bench.%ld", dir,
+           (long)getpid());
+
+  printf("Looking up %d keys in %zu sorted keys\n", QUERIES, n);
+  printf("dataset,method,warm_mlookups_per_s,cold_us,cold_pages_per_lookup\n");
+  for (int d = 0; d < 3; ++d) {
+    overflow_dataset_generate(keys, n, &specs[d], 0);
+    if (overflow_runfile_write(path, keys, NULL, n,
+                               OVERFLOW_RUNFILE_SUB_BITS) != 0) {
+      fprintf(stderr, "Cannot write %s\n", path);
+      return 1;
+    }
+
+    overflow_rng rng;
+    overflow_rng_seed(&rng, 50 + d);
+    for (size_t i = 0; i < QUERIES; ++i) {
+      uint64_t r = overflow_rng_next(&rng);
+      queries[i] = r & 1 ? keys[(r >> 1) % n] : (uint32_t)(r >> 32);
+    }
+
+    const char *methods[] = {"binary_search", "directory"};
+    size_t sums[2];
+    for (int m = 0; m < 2; ++m) {
+      Result r = run(path, queries, QUERIES, m, &sums[m]);
+      printf("%s,%s,%.2f,%.1f,%.2f\n", names[d], methods[m],
+             QUERIES / r.warm_s / 1e6, r.cold_us, r.cold_pages);
+    }
+    if (sums[0] != sums[1])
+      printf("%s: results differ\n", names[d]);
+  }
+
+  remove(path);
+  free(keys);
+  free(queries);
+  return 0;
+}
@@ -0,0 +1,87 @@
+/**
+ * @file skew_bench.c
+ * @brief Parallel sort of skewed keys with and without tick splitting.
+ *
+ * Usage: skew_bench [keys] [threads]   (default 20M, all online CPUs)
+ *
+ * Normal and narrow lognormal keys put nearly everything into one or two
+ * ticks, so partitioning by tick alone leaves one worker refining most of
+ * the array. Each row reports time, partition count and imbalance (the
+ * largest partition over n / threads).
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "overflow_dataset.h"
+#include "overflow_parallel.h"
+
+#define DEFAULT_SIZE 20000000
+
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void run(const char *name, const uint32_t *input, uint32_t *keys,
+                uint32_t *scratch, size_t n, unsigned threads,
+                int tick_only) {
+  overflow_parallel_stats stats;
+  overflow_parallel_opts opts = {
+      .threads = threads, .tick_only = tick_only, .stats = &stats};
+
+  for (size_t i = 0; i < n; ++i)
+    keys[i] = input[i];
+  double start = now_sec();
+  overflow_sort_parallel_opts_u32(keys, n, scratch, &opts);
+  double t = now_sec() - start;
+
+  for (size_t i = 1; i < n; ++i) {
+    if (keys[i - 1] > keys[i]) {
+      printf("%s: output not sorted\n", name);
+      break;
+    }
+  }
+  printf("%s %s,%.6f,%u,%u,%.2f\n", name, tick_only ? "tick-only" : "split",
+         t, stats.threads, stats.partitions, stats.imbalance);
+}
+
+int main(int argc, char **argv) {
+  size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : DEFAULT_SIZE;
+  unsigned threads = argc > 2 ? (unsigned)atoi(argv[2]) : 0;
+  const char *names[] = {"uniform", "normal", "lognormal"};
+  overflow_dataset_spec specs[] = {
+      {.dist = OVERFLOW_DIST_UNIFORM, .seed = 42},
+      {.dist = OVERFLOW_DIST_NORMAL, .seed = 42, .a = 3e6, .b = 2e5},
+      {.dist = OVERFLOW_DIST_LOGNORMAL, .seed = 42, .a = 15, .b = 0.3},
+  };
+
+  uint32_t *input = malloc(sizeof(uint32_t) * n);
+  uint32_t *keys = malloc(sizeof(uint32_t) * n);
+  uint32_t *scratch = malloc(sizeof(uint32_t) * n);
+  if (!input || !keys || !scratch) {
+    fprintf(stderr, "Memory allocation failed\n");
+    return 1;
+  }
+
+  printf("Sorting %zu keys, %u threads\n", n,
+         overflow_parallel_team_size(n, threads));
+  printf("variant,seconds,threads,partitions,imbalance\n");
+  for (int d = 0; d < 3; ++d) {
+    overflow_dataset_generate(input, n, &specs[d], 0);
+    run(names[d], input, keys, scratch, n, threads, 1);
+    run(names[d], input, keys, scratch, n, threads, 0);
+  }
+
+  free(input);
+  free(keys);
+  free(scratch);
+  return 0;
+}
@@ -0,0 +1,89 @@
+/**
+ * @file stream_bench.c
+ * @brief Streaming ingest against loading everything, then sorting.
+ *
+ * Usage: stream_bench [keys] [cache_dir]   (default 100M)
+ *
+ * A uniform dataset is written to a file once, then read back through
+ * `cat file |` twice: once into one big array that overflow_sort_u32()
+ * sorts after the pipe closes, and once through overflow_stream_read_fd(),
+ * which scatters each chunk while the next one is still in the pipe.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "overflow_dataset.h"
+#include "overflow_engine.h"
+#include "overflow_stream.h"
+
+#define DEFAULT_N 100000000
+
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char **argv) {
+  size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : DEFAULT_N;
+  const char *dir = argc > 2 ? argv[2] : "/tmp";
+  overflow_dataset_spec spec = {OVERFLOW_DIST_UNIFORM, 37, 0, 0, 0};
+  char path[4096], cmd[4200];
+
+  snprintf(path, sizeof(path), "%s/stream_bench_%zu.bin", dir, n);
+  uint32_t *keys = overflow_dataset_load(NULL, n, &spec, 0);
+  FILE *f = keys ? fopen(path, "wb") : NULL;
+  if (!f || fwrite(keys, sizeof(uint32_t), n, f) != n) {
+    fprintf(stderr, "Can't write %s\n", path);
+    return 1;
+  }
+  fclose(f);
+  overflow_dataset_release(keys, n);
+  snprintf(cmd, sizeof(cmd), "cat %s", path);
+
+  uint32_t *all = malloc(sizeof(uint32_t) * n);
+  uint32_t *out = malloc(sizeof(uint32_t) * n);
+
+  // Load everything, then sort
+  double t0 = now_sec();
+  FILE *p = popen(cmd, "r");
+  size_t got = fread(all, sizeof(uint32_t), n, p);
+  pclose(p);
+  double t_read = now_sec() - t0;
+  overflow_sort_u32(all, got);
+  double t_load = now_sec() - t0;
+
+  // Stream: scatter overlaps the pipe
+  overflow_stream *s = overflow_stream_create(0);
+  t0 = now_sec();
+  p = popen(cmd, "r");
+  overflow_stream_read_fd(s, fileno(p));
+  pclose(p);
+  double t_ingest = now_sec() - t0;
+  overflow_stream_finish(s, out);
+  double t_stream = now_sec() - t0;
+  overflow_stream_destroy(s);
+
+  int ok = got == n && memcmp(all, out, sizeof(uint32_t) * n) == 0;
+  printf("keys           : %zu\n", n);
+  printf("load then sort : %.3f s (read %.3f s, sort %.3f s)\n", t_load,
+         t_read, t_load - t_read);
+  printf("stream         : %.3f s (ingest %.3f s, finish %.3f s)\n",
+         t_stream, t_ingest, t_stream - t_ingest);
+  printf("speedup        : %.2fx%s\n", t_load / t_stream,
+         ok ? "" : "  (MISMATCH)");
+
+  unlink(path);
+  free(all);
+  free(out);
+  return ok ? 0 : 1;
+}
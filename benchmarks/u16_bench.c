@@ -0,0 +1,113 @@
+/**
+ * @file u16_bench.c
+ * @brief Two-level uint16_t counting sort against radix_sort_uint16().
+ *
+ * Usage: u16_bench [max_keys]   (default 100M; 1B needs ~5 GB of RAM)
+ *
+ * Sizes run from 1K up to max_keys in steps of 10, on full-range keys
+ * (`rand() % 65536`) and on the clamped normal values from
+ * generate_realworld_value().
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "overflow_u16.h"
+
+#define DEFAULT_MAX 100000000
+
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Baseline from sort_scaling_benchmark.c, widened to size_t
+void radix_sort_uint16(uint16_t arr[], size_t size) {
+  uint16_t *output = malloc(sizeof(uint16_t) * size);
+  size_t count[256];
+
+  for (int shift = 0; shift < 16; shift += 8) {
+    memset(count, 0, sizeof(count));
+    for (size_t i = 0; i < size; ++i)
+      count[(arr[i] >> shift) & 0xFF]++;
+
+    for (int i = 1; i < 256; ++i)
+      count[i] += count[i - 1];
+
+    for (size_t i = size; i-- > 0;)
+      output[--count[(arr[i] >> shift) & 0xFF]] = arr[i];
+
+    memcpy(arr, output, sizeof(uint16_t) * size);
+  }
+
+  free(output);
+}
+
+uint16_t generate_realworld_value() {
+  double u1 = ((double)rand() + 1.0) / ((double)RAND_MAX + 2.0);
+  double u2 = ((double)rand() + 1.0) / ((double)RAND_MAX + 2.0);
+  double z = sqrt(-2.0 * log(u1)) * cos(2 * M_PI * u2);
+  double val = 128 + z * 40;
+  if (val < 0)
+    val = 0;
+  if (val > 255)
+    val = 255;
+  return (uint16_t)val;
+}
+
+int main(int argc, char **argv) {
+  size_t max = argc > 1 ? strtoull(argv[1], NULL, 10) : DEFAULT_MAX;
+  const char *dists[] = {"full-range", "realworld"};
+
+  uint16_t *input = malloc(sizeof(uint16_t) * max);
+  uint16_t *keys = malloc(sizeof(uint16_t) * max);
+  if (!input || !keys) {
+    fprintf(stderr, "Memory allocation failed\n");
+    return 1;
+  }
+
+  srand((unsigned int)time(NULL));
+  printf("dist,n,two_level_s,radix_s\n");
+  for (int d = 0; d < 2; ++d) {
+    for (size_t i = 0; i < max; ++i)
+      input[i] = d == 0 ? (uint16_t)(rand() % 65536)
+                        : generate_realworld_value();
+
+    for (size_t n = 1000; n <= max; n *= 10) {
+      memcpy(keys, input, sizeof(uint16_t) * n);
+      double start = now_sec();
+      if (overflow_sort_u16(keys, n) != 0) {
+        fprintf(stderr, "Memory allocation failed\n");
+        return 1;
+      }
+      double t_two = now_sec() - start;
+
+      for (size_t i = 1; i < n; ++i) {
+        if (keys[i - 1] > keys[i]) {
+          printf("%s: output not sorted at %zu\n", dists[d], i);
+          break;
+        }
+      }
+
+      memcpy(keys, input, sizeof(uint16_t) * n);
+      start = now_sec();
+      radix_sort_uint16(keys, n);
+      double t_radix = now_sec() - start;
+
+      printf("%s,%zu,%.6f,%.6f\n", dists[d], n, t_two, t_radix);
+    }
+  }
+
+  free(input);
+  free(keys);
+  return 0;
+}
@@ -0,0 +1,85 @@
+/**
+ * @file u8_bench.c
+ * @brief Byte-key engine throughput against a plain memcpy of the input.
+ *
+ * Usage: u8_bench [bytes]   (default 1 GiB)
+ *
+ * The counting sort reads the array once and writes it once, so memcpy of
+ * the same size is the bandwidth ceiling it should approach.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "overflow_parallel.h"
+#include "overflow_u8.h"
+
+#define DEFAULT_SIZE (1ull << 30)
+
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void fill(uint8_t *keys, size_t n) {
+  for (size_t i = 0; i < n; ++i)
+    keys[i] = (uint8_t)rand();
+}
+
+int main(int argc, char **argv) {
+  size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : DEFAULT_SIZE;
+  uint8_t *keys = malloc(n);
+  uint8_t *copy = malloc(n);
+  if (!keys || !copy) {
+    fprintf(stderr, "Memory allocation failed\n");
+    return 1;
+  }
+
+  srand((unsigned int)time(NULL));
+  fill(keys, n);
+  memcpy(copy, keys, n);
+
+  printf("Sorting %zu bytes, %u threads\n", n, overflow_parallel_threads());
+  printf("variant,seconds,GB/s\n");
+
+  double start = now_sec();
+  memcpy(copy, keys, n);
+  double t = now_sec() - start;
+  printf("memcpy,%.6f,%.2f\n", t, n / t * 1e-9);
+
+  start = now_sec();
+  overflow_sort_u8(keys, n, 0);
+  t = now_sec() - start;
+  printf("overflow_sort_u8,%.6f,%.2f\n", t, n / t * 1e-9);
+
+  for (size_t i = 1; i < n; ++i) {
+    if (keys[i - 1] > keys[i]) {
+      printf("output not sorted at %zu\n", i);
+      break;
+    }
+  }
+
+  memcpy(keys, copy, n);
+  start = now_sec();
+  overflow_sort_u8_threads(keys, n, 0, 0);
+  t = now_sec() - start;
+  printf("overflow_sort_u8_threads,%.6f,%.2f\n", t, n / t * 1e-9);
+
+  memcpy(keys, copy, n);
+  start = now_sec();
+  overflow_sort_u8(keys, n, OVERFLOW_U8_TICKS_ONLY);
+  t = now_sec() - start;
+  printf("ticks only,%.6f,%.2f\n", t, n / t * 1e-9);
+
+  free(keys);
+  free(copy);
+  return 0;
+}
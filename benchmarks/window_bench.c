@@ -0,0 +1,113 @@
+/**
+ * @file window_bench.c
+ * @brief Per-window latency of the windowed sorter against fresh sorts.
+ *
+ * Usage: window_bench [windows] [keys_per_window]   (default 100 x 1M)
+ *
+ * Keys are pushed in 4K batches as fast as possible and every window is
+ * closed after keys_per_window of them. Latency runs from the close to
+ * the end of the emit callback. The baseline copies each closed window
+ * into a fresh allocation and sorts it with overflow_sort_u32() before
+ * ingest continues, which is what a per-window sort call costs today.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "overflow_dataset.h"
+#include "overflow_engine.h"
+#include "overflow_window.h"
+
+#define BATCH 4096
+
+typedef struct {
+  double *closed; // Close time of each window
+  double *latency;
+  uint64_t checksum;
+} Timing;
+
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int cmp_double(const void *a, const void *b) {
+  double x = *(const double *)a, y = *(const double *)b;
+  return (x > y) - (x < y);
+}
+
+static void record(void *arg, uint64_t window, const uint32_t *keys,
+                   size_t n) {
+  Timing *t = arg;
+  t->checksum += n ? keys[0] ^ keys[n / 2] ^ keys[n - 1] : 0;
+  t->latency[window] = now_sec() - t->closed[window];
+}
+
+static void report(const char *name, Timing *t, size_t windows, double wall) {
+  qsort(t->latency, windows, sizeof(double), cmp_double);
+  printf("%-10s p50 %8.3f ms   p99 %8.3f ms   wall %7.3f s\n", name,
+         t->latency[windows / 2] * 1e3,
+         t->latency[(windows * 99) / 100] * 1e3, wall);
+}
+
+int main(int argc, char **argv) {
+  size_t windows = argc > 1 ? strtoull(argv[1], NULL, 10) : 100;
+  size_t per = argc > 2 ? strtoull(argv[2], NULL, 10) : 1000000;
+  overflow_dataset_spec spec = {OVERFLOW_DIST_LOGNORMAL, 38, 9.0, 1.5, 0};
+  size_t total = windows * per;
+  uint32_t *keys = overflow_dataset_load(NULL, total, &spec, 0);
+  Timing t = {malloc(sizeof(double) * windows),
+              malloc(sizeof(double) * windows), 0};
+
+  if (!keys) {
+    fprintf(stderr, "Can't generate %zu keys\n", total);
+    return 1;
+  }
+  printf("%zu windows of %zu lognormal keys\n", windows, per);
+
+  // Windowed sorter: sort of window k overlaps ingest of window k+1
+  overflow_window *win = overflow_window_create(record, &t, 0);
+  double t0 = now_sec();
+  for (size_t w = 0; w < windows; ++w) {
+    const uint32_t *src = keys + w * per;
+    for (size_t i = 0; i < per; i += BATCH)
+      overflow_window_push(win, src + i, per - i < BATCH ? per - i : BATCH);
+    t.closed[w] = now_sec();
+    overflow_window_close(win);
+  }
+  overflow_window_flush(win);
+  report("window", &t, windows, now_sec() - t0);
+  overflow_window_destroy(win);
+  uint64_t window_sum = t.checksum;
+
+  // Baseline: fresh buffer and a blocking sort per window
+  t.checksum = 0;
+  t0 = now_sec();
+  for (size_t w = 0; w < windows; ++w) {
+    uint32_t *buf = malloc(sizeof(uint32_t) * per);
+    const uint32_t *src = keys + w * per;
+    for (size_t i = 0; i < per; i += BATCH)
+      memcpy(buf + i, src + i,
+             sizeof(uint32_t) * (per - i < BATCH ? per - i : BATCH));
+    t.closed[w] = now_sec();
+    overflow_sort_u32(buf, per);
+    record(&t, w, buf, per);
+    free(buf);
+  }
+  report("fresh", &t, windows, now_sec() - t0);
+
+  if (window_sum != t.checksum)
+    printf("Checksum mismatch\n");
+  overflow_dataset_release(keys, total);
+  free(t.closed);
+  free(t.latency);
+  return window_sum != t.checksum;
+}
@@ -0,0 +1,313 @@
+/**
+ * @file _overflow.cpp
+ * @brief CPython extension exposing the sort engines to any buffer.
+ *
+ * Works on anything with a C-contiguous 1-D buffer (NumPy arrays, array,
+ * memoryview) of 8- to 64-bit integers or float32/float64, in place and
+ * without copying the keys. The GIL is released while sorting. Byte,
+ * uint16 and uint32 keys go to the dedicated C engines; every other type
+ * goes through overflow.hpp. overflow_np.py wraps this for NumPy users.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <span>
+
+#include "overflow.hpp"
+
+extern "C" {
+#include "overflow_engine.h"
+#include "overflow_parallel.h"
+#include "overflow_u16.h"
+#include "overflow_u8.h"
+}
+
+namespace {
+
+enum Kind { U8, U16, U32, U64, I8, I16, I32, I64, F32, F64, UNSUPPORTED };
+
+// Maps a buffer format to a key kind; only native byte order is accepted.
+Kind kind_of(const Py_buffer &view) {
+  const char *f = view.format ? view.format : "B";
+  if (*f == '@' || *f == '=' || (*f == '<' && PY_LITTLE_ENDIAN) ||
+      (*f == '>' && !PY_LITTLE_ENDIAN))
+    ++f;
+  if (f[0] == '\0' || f[1] != '\0')
+    return UNSUPPORTED;
+
+  Py_ssize_t size = view.itemsize;
+  switch (f[0]) {
+  case 'B': case 'H': case 'I': case 'L': case 'Q':
+    return size == 1 ? U8 : size == 2 ? U16 : size == 4 ? U32
+         : size == 8 ? U64 : UNSUPPORTED;
+  case 'b': case 'h': case 'i': case 'l': case 'q':
+    return size == 1 ? I8 : size == 2 ? I16 : size == 4 ? I32
+         : size == 8 ? I64 : UNSUPPORTED;
+  case 'f':
+    return size == 4 ? F32 : UNSUPPORTED;
+  case 'd':
+    return size == 8 ? F64 : UNSUPPORTED;
+  default:
+    return UNSUPPORTED;
+  }
+}
+
+// NumPy orders every NaN last and treats -0.0 == 0.0; the engines order
+// by IEEE bits, so drop the signs that would break ties differently.
+template <class K> K canonical(K k) {
+  if constexpr (std::is_floating_point_v<K>) {
+    if (std::isnan(k))
+      return std::fabs(k);
+    if (k == 0)
+      return K(0);
+  }
+  return k;
+}
+
+// Every entry point returns 0 on success, -1 on allocation failure.
+template <class K> int sort_keys(K *keys, size_t n, unsigned threads) {
+  std::span<K> span(keys, n);
+  try {
+    // Floats are ordered through canonical(), so every NaN sorts last while
+    // the caller's values are only moved, never rewritten
+    if constexpr (std::is_floating_point_v<K>) {
+      auto key = [](K k) { return canonical(k); };
+      if (threads == 1)
+        overflow::sort(span, key);
+      else
+        overflow::sort(overflow::parallel_policy{threads}, span, key);
+    } else if (threads == 1) {
+      overflow::sort(span);
+    } else {
+      overflow::sort(overflow::parallel_policy{threads}, span);
+    }
+  } catch (const std::bad_alloc &) {
+    return -1;
+  }
+  return 0;
+}
+
+template <> int sort_keys(uint8_t *keys, size_t n, unsigned threads) {
+  overflow_sort_u8_threads(keys, n, threads, 0);
+  return 0;
+}
+
+template <> int sort_keys(uint16_t *keys, size_t n, unsigned) {
+  return overflow_sort_u16(keys, n);
+}
+
+template <> int sort_keys(uint32_t *keys, size_t n, unsigned threads) {
+  if (threads == 1 || overflow_parallel_team_size(n, threads) == 1)
+    return overflow_sort_u32(keys, n);
+
+  uint32_t *scratch = static_cast<uint32_t *>(malloc(n * sizeof(uint32_t)));
+  if (!scratch)
+    return -1;
+  overflow_sort_parallel_u32(keys, n, scratch, threads);
+  free(scratch);
+  return 0;
+}
+
+// Stable argsort: sort (key, index) records by key, then read the indices.
+template <class K, class Idx>
+int argsort_records(const K *keys, int64_t *out, size_t n, unsigned threads) {
+  struct Rec {
+    K key;
+    Idx idx;
+  };
+
+  try {
+    auto recs = std::make_unique_for_overwrite<Rec[]>(n);
+    for (size_t i = 0; i < n; ++i)
+      recs[i] = {canonical(keys[i]), Idx(i)};
+
+    std::span<Rec> span(recs.get(), n);
+    auto key = [](const Rec &r) { return r.key; };
+    if (threads == 1)
+      overflow::sort(span, key);
+    else
+      overflow::sort(overflow::parallel_policy{threads}, span, key);
+
+    for (size_t i = 0; i < n; ++i)
+      out[i] = int64_t(recs[i].idx);
+  } catch (const std::bad_alloc &) {
+    return -1;
+  }
+  return 0;
+}
+
+// 8- and 16-bit keys: one stable counting pass straight into out.
+template <class K>
+int counting_argsort(const K *keys, int64_t *out, size_t n) {
+  using Tr = overflow::key_traits<K>;
+  constexpr size_t bins = size_t(1) << Tr::bits;
+
+  size_t *cursor = static_cast<size_t *>(calloc(bins, sizeof(size_t)));
+  if (!cursor)
+    return -1;
+  for (size_t i = 0; i < n; ++i)
+    cursor[Tr::template encode<overflow::ascending>(keys[i])]++;
+  size_t sum = 0;
+  for (size_t b = 0; b < bins; ++b) {
+    size_t c = cursor[b];
+    cursor[b] = sum;
+    sum += c;
+  }
+  for (size_t i = 0; i < n; ++i)
+    out[cursor[Tr::template encode<overflow::ascending>(keys[i])]++] =
+        int64_t(i);
+  free(cursor);
+  return 0;
+}
+
+template <class K>
+int argsort_keys(const K *keys, int64_t *out, size_t n, unsigned threads) {
+  if constexpr (sizeof(K) <= 2)
+    return counting_argsort(keys, out, n);
+
+  // 32-bit indices keep narrow records at 8 bytes
+  if (n <= UINT32_MAX)
+    return argsort_records<K, uint32_t>(keys, out, n, threads);
+  return argsort_records<K, uint64_t>(keys, out, n, threads);
+}
+
+template <class Fn> int dispatch(Kind kind, void *buf, Fn &&fn) {
+  switch (kind) {
+  case U8: return fn(static_cast<uint8_t *>(buf));
+  case U16: return fn(static_cast<uint16_t *>(buf));
+  case U32: return fn(static_cast<uint32_t *>(buf));
+  case U64: return fn(static_cast<uint64_t *>(buf));
+  case I8: return fn(static_cast<int8_t *>(buf));
+  case I16: return fn(static_cast<int16_t *>(buf));
+  case I32: return fn(static_cast<int32_t *>(buf));
+  case I64: return fn(static_cast<int64_t *>(buf));
+  case F32: return fn(static_cast<float *>(buf));
+  case F64: return fn(static_cast<double *>(buf));
+  default: return -1;
+  }
+}
+
+// Fetches a C-contiguous 1-D key buffer; sets a Python error and returns
+// UNSUPPORTED on failure (with the buffer released).
+Kind get_keys(PyObject *obj, Py_buffer *view, int writable) {
+  int flags = PyBUF_FORMAT | PyBUF_C_CONTIGUOUS;
+  if (writable)
+    flags |= PyBUF_WRITABLE;
+  if (PyObject_GetBuffer(obj, view, flags) != 0)
+    return UNSUPPORTED;
+
+  Kind kind = kind_of(*view);
+  if (view->ndim != 1) {
+    PyErr_SetString(PyExc_ValueError, "expected a 1-D array");
+    kind = UNSUPPORTED;
+  } else if (kind == UNSUPPORTED) {
+    PyErr_Format(PyExc_TypeError, "unsupported key format '%s'",
+                 view->format ? view->format : "B");
+  }
+  if (kind == UNSUPPORTED)
+    PyBuffer_Release(view);
+  return kind;
+}
+
+PyObject *py_sort(PyObject *, PyObject *args, PyObject *kwargs) {
+  static const char *kwlist[] = {"keys", "threads", nullptr};
+  PyObject *obj;
+  unsigned threads = 0;
+  Py_buffer view;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|I",
+                                   const_cast<char **>(kwlist), &obj,
+                                   &threads))
+    return nullptr;
+  Kind kind = get_keys(obj, &view, 1);
+  if (kind == UNSUPPORTED)
+    return nullptr;
+
+  size_t n = size_t(view.shape[0]);
+  int rc;
+  Py_BEGIN_ALLOW_THREADS
+  rc = dispatch(kind, view.buf, [&](auto *keys) {
+    return sort_keys(keys, n, threads);
+  });
+  Py_END_ALLOW_THREADS
+  PyBuffer_Release(&view);
+
+  if (rc != 0)
+    return PyErr_NoMemory();
+  Py_RETURN_NONE;
+}
+
+PyObject *py_argsort(PyObject *, PyObject *args, PyObject *kwargs) {
+  static const char *kwlist[] = {"keys", "out", "threads", nullptr};
+  PyObject *obj, *out_obj;
+  unsigned threads = 0;
+  Py_buffer view, out;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|I",
+                                   const_cast<char **>(kwlist), &obj,
+                                   &out_obj, &threads))
+    return nullptr;
+  Kind kind = get_keys(obj, &view, 0);
+  if (kind == UNSUPPORTED)
+    return nullptr;
+  Kind out_kind = get_keys(out_obj, &out, 1);
+  if (out_kind != I64) {
+    if (out_kind != UNSUPPORTED)
+      PyBuffer_Release(&out);
+    PyBuffer_Release(&view);
+    PyErr_Clear();
+    PyErr_SetString(PyExc_TypeError, "out must be a writable 1-D int64 array");
+    return nullptr;
+  }
+
+  size_t n = size_t(view.shape[0]);
+  if (out.shape[0] != view.shape[0]) {
+    PyBuffer_Release(&view);
+    PyBuffer_Release(&out);
+    PyErr_SetString(PyExc_ValueError, "out must have the length of keys");
+    return nullptr;
+  }
+
+  int rc;
+  int64_t *idx = static_cast<int64_t *>(out.buf);
+  Py_BEGIN_ALLOW_THREADS
+  rc = dispatch(kind, view.buf, [&](auto *keys) {
+    return argsort_keys(keys, idx, n, threads);
+  });
+  Py_END_ALLOW_THREADS
+  PyBuffer_Release(&view);
+  PyBuffer_Release(&out);
+
+  if (rc != 0)
+    return PyErr_NoMemory();
+  Py_RETURN_NONE;
+}
+
+PyMethodDef methods[] = {
+    {"sort", reinterpret_cast<PyCFunction>(py_sort),
+     METH_VARARGS | METH_KEYWORDS,
+     "sort(keys, threads=0)\n\nSorts a contiguous 1-D buffer in place. "
+     "threads=0 uses all CPUs, 1 stays on the calling thread."},
+    {"argsort", reinterpret_cast<PyCFunction>(py_argsort),
+     METH_VARARGS | METH_KEYWORDS,
+     "argsort(keys, out, threads=0)\n\nWrites the stable sorting "
+     "permutation of keys into the int64 buffer out."},
+    {nullptr, nullptr, 0, nullptr}};
+
+PyModuleDef module = {PyModuleDef_HEAD_INIT, "_overflow",
+                      "Overflow sort engines over the buffer protocol.", -1,
+                      methods};
+
+} // namespace
+
+PyMODINIT_FUNC PyInit__overflow(void) { return PyModule_Create(&module); }
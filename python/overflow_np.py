@@ -0,0 +1,32 @@
+"""
+NumPy front end for the overflow sort engines.
+
+    import numpy as np
+    import overflow_np
+
+    a = np.random.randint(0, 2**31, 10_000_000, dtype=np.uint32)
+    overflow_np.sort(a)              # in place, all CPUs, GIL released
+    idx = overflow_np.argsort(a)     # same as np.argsort(a, kind="stable")
+
+Arrays must be 1-D and C-contiguous with a native-endian integer (8 to 64
+bit) or float32/float64 dtype. NaNs sort last, as in NumPy.
+
+Build with `make python`; the extension lands in build/.
+"""
+
+import numpy as np
+
+import _overflow
+
+
+def sort(a, threads=0):
+    """Sorts a in place and returns it. threads=0 uses all CPUs."""
+    _overflow.sort(a, threads)
+    return a
+
+
+def argsort(a, threads=0):
+    """Returns the stable sorting permutation of a as int64 indices."""
+    out = np.empty(len(a), dtype=np.int64)
+    _overflow.argsort(a, out, threads)
+    return out
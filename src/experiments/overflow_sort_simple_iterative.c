@@ -11,21 +11,29 @@ typedef struct {
   int index;
 } SortedEntry;
 
-SortedEntry *sorted_array = NULL;
-int sorted_count = 0;
-int sorted_capacity = 0;
+// Output state lives with the caller so concurrent sorts don't collide
+typedef struct {
+  SortedEntry *sorted_array;
+  int sorted_count;
+  int sorted_capacity;
+} SortedList;
 
-void insert_sorted(uint16_t value, int index) {
+void insert_sorted(SortedList *list, uint16_t value, int index) {
   // Expand sorted array if needed
-  if (sorted_count >= sorted_capacity) {
-    sorted_capacity = (sorted_capacity == 0) ? 1024 : sorted_capacity * 2;
-    sorted_array = realloc(sorted_array, sorted_capacity * sizeof(SortedEntry));
-    if (!sorted_array) {
+  if (list->sorted_count >= list->sorted_capacity) {
+    list->sorted_capacity =
+        (list->sorted_capacity == 0) ? 1024 : list->sorted_capacity * 2;
+    list->sorted_array = realloc(list->sorted_array,
+                                 list->sorted_capacity * sizeof(SortedEntry));
+    if (!list->sorted_array) {
       fprintf(stderr, "Memory allocation failed.\n");
       exit(1);
     }
   }
 
+  SortedEntry *sorted_array = list->sorted_array;
+  int sorted_count = list->sorted_count;
+
   // Find insertion point
   int pos = 0;
   while (pos < sorted_count) {
@@ -42,10 +50,11 @@ void insert_sorted(uint16_t value, int index) {
   }
   sorted_array[pos].value = value;
   sorted_array[pos].index = index;
-  sorted_count++;
+  list->sorted_count++;
 }
 
-void overflow_sort(uint16_t *arr, uint16_t *orig_vals, int *indices, int size) {
+void overflow_sort(SortedList *list, uint16_t *arr, uint16_t *orig_vals,
+                   int *indices, int size) {
   uint16_t *next_arr = malloc(size * sizeof(uint16_t));
   uint16_t *next_vals = malloc(size * sizeof(uint16_t));
   int *next_indices = malloc(size * sizeof(int));
@@ -54,7 +63,7 @@ void overflow_sort(uint16_t *arr, uint16_t *orig_vals, int *indices, int size) {
   for (int i = 0; i < size; i++) {
     uint16_t doubled = arr[i] * 2;
     if (doubled > THRESHOLD) {
-      insert_sorted(orig_vals[i], indices[i]);
+      insert_sorted(list, orig_vals[i], indices[i]);
     } else {
       next_arr[next_size] = doubled;
       next_vals[next_size] = orig_vals[i];
@@ -63,8 +72,12 @@ void overflow_sort(uint16_t *arr, uint16_t *orig_vals, int *indices, int size) {
     }
   }
 
-  if (next_size > 0) {
-    overflow_sort(next_arr, next_vals, next_indices, next_size);
+  if (next_size == size) {
+    // Nothing overflowed: only zeros are left and they never will
+    for (int i = 0; i < next_size; i++)
+      insert_sorted(list, next_vals[i], next_indices[i]);
+  } else if (next_size > 0) {
+    overflow_sort(list, next_arr, next_vals, next_indices, next_size);
   }
 
   free(next_arr);
@@ -88,19 +101,20 @@ int main() {
   printf("Original: [%u, %u, %u, %u, %u ...]\n", data[0], data[1], data[2],
          data[3], data[4]);
 
+  SortedList list = {NULL, 0, 0};
   clock_t start = clock();
-  overflow_sort(data, orig_vals, indices, SIZE);
+  overflow_sort(&list, data, orig_vals, indices, SIZE);
   clock_t end = clock();
 
   printf("Sorted by recursive overflow (first 10):\n");
-  for (int i = 0; i < sorted_count && i < 10; i++) {
-    printf("%u ", sorted_array[i].value);
+  for (int i = 0; i < list.sorted_count && i < 10; i++) {
+    printf("%u ", list.sorted_array[i].value);
   }
   printf("\nTime taken: %.6f sec\n", (double)(end - start) / CLOCKS_PER_SEC);
 
   free(data);
   free(orig_vals);
   free(indices);
-  free(sorted_array);
+  free(list.sorted_array);
   return 0;
 }
@@ -0,0 +1,577 @@
+/**
+ * @file overflow.hpp
+ * @brief Header-only C++ front end for the tick-bucket sort.
+ *
+ * overflow::sort() takes any contiguous range of integer or floating-point
+ * keys, or of records ordered by an arithmetic projection. The tick count,
+ * lane width and radix parameters are constants of the key type, so every
+ * instantiation gets its own kernel instead of sharing one set of
+ * per-translation-unit macros:
+ *
+ *   overflow::sort(v);                               // ascending, stable
+ *   overflow::sort<overflow::descending>(v);
+ *   overflow::sort(rows, [](const Row &r) { return r.ts; });
+ *   overflow::sort(overflow::par, v);                // all hardware threads
+ *
+ * Keys that share a high offset are ticked relative to their minimum, which
+ * the tick histogram pass finds on the way (`no_rebase` ticks raw keys).
+ *
+ * Records must be trivially copyable. Floating-point keys order by their
+ * IEEE bits, so -0.0 sorts before +0.0 and NaNs go to the ends by sign.
+ * Scratch allocation failures surface as std::bad_alloc.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#ifndef OVERFLOW_HPP
+#define OVERFLOW_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace overflow {
+
+// Order flags, passed as the first template argument
+inline constexpr unsigned ascending = 0;
+inline constexpr unsigned descending = 0x1;
+inline constexpr unsigned unstable = 0x2; // Records with equal keys may swap
+inline constexpr unsigned no_rebase = 0x4; // Tick raw keys, never key - min
+
+// Execution policies
+struct sequenced_policy {};
+struct parallel_policy {
+  unsigned threads = 0; // 0 = std::thread::hardware_concurrency()
+};
+inline constexpr sequenced_policy seq{};
+inline constexpr parallel_policy par{};
+
+namespace detail {
+
+template <std::size_t Bytes> struct unsigned_of;
+template <> struct unsigned_of<1> { using type = std::uint8_t; };
+template <> struct unsigned_of<2> { using type = std::uint16_t; };
+template <> struct unsigned_of<4> { using type = std::uint32_t; };
+template <> struct unsigned_of<8> { using type = std::uint64_t; };
+
+} // namespace detail
+
+template <class K>
+concept sort_key = std::is_arithmetic_v<K> && !std::is_same_v<K, bool> &&
+                   (sizeof(K) == 1 || sizeof(K) == 2 || sizeof(K) == 4 ||
+                    sizeof(K) == 8);
+
+// Compile-time parameters for one key type.
+template <sort_key K> struct key_traits {
+  using unsigned_type = typename detail::unsigned_of<sizeof(K)>::type;
+
+  static constexpr unsigned bits = sizeof(K) * CHAR_BIT;
+  static constexpr unsigned ticks = bits + 1;         // Buckets 0..bits
+  static constexpr unsigned lanes = 32 / sizeof(K);   // Keys per 256-bit vector
+  static constexpr unsigned digit_bits = bits < 8 ? bits : 8;
+  static constexpr unsigned digit_bins = 1u << digit_bits;
+  static constexpr std::size_t network_max = 16;
+  static constexpr std::size_t insertion_max = 48;
+  static constexpr std::size_t parallel_min = 65536; // Keys per worker
+
+  // Order-preserving map onto unsigned_type; descending flips every bit.
+  template <unsigned Flags>
+  static constexpr unsigned_type encode(K key) noexcept {
+    constexpr unsigned_type top = unsigned_type(1) << (bits - 1);
+    auto u = std::bit_cast<unsigned_type>(key);
+    if constexpr (std::is_floating_point_v<K>)
+      u = (u & top) ? unsigned_type(~u) : unsigned_type(u | top);
+    else if constexpr (std::is_signed_v<K>)
+      u = unsigned_type(u ^ top);
+    if constexpr (Flags & descending)
+      u = unsigned_type(~u);
+    return u;
+  }
+
+  static constexpr unsigned tick(unsigned_type u) noexcept {
+    return bits - unsigned(std::countl_zero(u));
+  }
+};
+
+namespace detail {
+
+template <class T, class KeyFn>
+using key_of = std::invoke_result_t<KeyFn &, const T &>;
+
+template <class T, class KeyFn>
+void insertion_sort(T *a, std::size_t n, KeyFn &key) {
+  for (std::size_t i = 1; i < n; ++i) {
+    T v = a[i];
+    auto kv = key(v);
+    std::size_t j = i;
+    while (j > 0 && key(a[j - 1]) > kv) {
+      a[j] = a[j - 1];
+      --j;
+    }
+    a[j] = v;
+  }
+}
+
+// Batcher odd-even merge network; Width is a constant so it unrolls into
+// straight-line compare-exchanges. Only used where reordering equal keys is
+// unobservable or allowed.
+template <std::size_t Width, class T, class KeyFn>
+void network_pow2(T *v, KeyFn &key) {
+  for (std::size_t p = 1; p < Width; p <<= 1)
+    for (std::size_t k = p; k >= 1; k >>= 1)
+      for (std::size_t j = k % p; j + k < Width; j += 2 * k)
+        for (std::size_t i = 0; i < k && i + j + k < Width; ++i)
+          if ((i + j) / (2 * p) == (i + j + k) / (2 * p)) {
+            T &a = v[i + j];
+            T &b = v[i + j + k];
+            bool swap = key(b) < key(a);
+            T lo = swap ? b : a;
+            T hi = swap ? a : b;
+            a = lo;
+            b = hi;
+          }
+}
+
+template <std::size_t Max, class T, class KeyFn>
+void network_sort(T *a, std::size_t n, KeyFn &key) {
+  T pad[Max];
+  std::size_t top = 0;
+
+  // Pad with copies of the largest key so they stay past position n
+  for (std::size_t i = 0; i < n; ++i) {
+    pad[i] = a[i];
+    if (key(a[top]) < key(a[i]))
+      top = i;
+  }
+  for (std::size_t i = n; i < Max; ++i)
+    pad[i] = a[top];
+
+  if (n <= 4)
+    network_pow2<4>(pad, key);
+  else if (n <= 8)
+    network_pow2<8>(pad, key);
+  else
+    network_pow2<Max>(pad, key);
+  std::memcpy(a, pad, n * sizeof(T));
+}
+
+// LSD radix over the low `bits` bits, ping-ponging a <-> b. Returns the
+// buffer holding the result.
+template <class Tr, class T, class KeyFn>
+T *radix_passes(T *a, T *b, std::size_t n, unsigned bits, KeyFn &key) {
+  constexpr unsigned mask = Tr::digit_bins - 1;
+  T *from = a;
+  T *to = b;
+
+  for (unsigned shift = 0; shift < bits; shift += Tr::digit_bits) {
+    std::size_t count[Tr::digit_bins] = {};
+    for (std::size_t i = 0; i < n; ++i)
+      count[(key(from[i]) >> shift) & mask]++;
+
+    // Skip digits every key agrees on
+    if (count[(key(from[0]) >> shift) & mask] == n)
+      continue;
+
+    std::size_t sum = 0;
+    for (unsigned d = 0; d < Tr::digit_bins; ++d) {
+      std::size_t c = count[d];
+      count[d] = sum;
+      sum += c;
+    }
+    for (std::size_t i = 0; i < n; ++i)
+      to[count[(key(from[i]) >> shift) & mask]++] = from[i];
+    std::swap(from, to);
+  }
+  return from;
+}
+
+// Sorts one tick bucket from src into dst, using src as the ping-pong
+// buffer.
+template <class Tr, class T, class KeyFn>
+void refine_bucket(T *src, T *dst, std::size_t n, unsigned tick,
+                   KeyFn &key) {
+  // Everything below the leading bit still needs ordering
+  unsigned bits = tick > 1 ? tick - 1 : 0;
+
+  if (n >= 2 && bits > 0 && n > Tr::insertion_max) {
+    T *result = radix_passes<Tr>(src, dst, n, bits, key);
+    if (result != dst)
+      std::memcpy(dst, result, n * sizeof(T));
+    return;
+  }
+  std::memcpy(dst, src, n * sizeof(T));
+  if (n >= 2 && bits > 0)
+    insertion_sort(dst, n, key);
+}
+
+// Tick histogram, computed a vector's worth of keys at a time so the tick
+// loop vectorizes on targets with a vector leading-zero count.
+template <class Tr, class T, class KeyFn>
+void tick_histogram(const T *a, std::size_t n, std::size_t *counts,
+                    KeyFn &key) {
+  std::size_t i = 0;
+  for (; i + Tr::lanes <= n; i += Tr::lanes) {
+    unsigned char t[Tr::lanes];
+    for (unsigned l = 0; l < Tr::lanes; ++l)
+      t[l] = (unsigned char)Tr::tick(key(a[i + l]));
+    for (unsigned l = 0; l < Tr::lanes; ++l)
+      counts[t[l]]++;
+  }
+  for (; i < n; ++i)
+    counts[Tr::tick(key(a[i]))]++;
+}
+
+// The same histogram, also narrowing [lo, hi] to the smallest and largest
+// key in the one pass; lo and hi start at any key of the input.
+template <class Tr, class T, class KeyFn, class U>
+void tick_histogram(const T *a, std::size_t n, std::size_t *counts,
+                    KeyFn &key, U &lo, U &hi) {
+  std::size_t i = 0;
+  for (; i + Tr::lanes <= n; i += Tr::lanes) {
+    U k[Tr::lanes];
+    unsigned char t[Tr::lanes];
+    for (unsigned l = 0; l < Tr::lanes; ++l)
+      k[l] = key(a[i + l]);
+    for (unsigned l = 0; l < Tr::lanes; ++l) {
+      t[l] = (unsigned char)Tr::tick(k[l]);
+      lo = k[l] < lo ? k[l] : lo;
+      hi = k[l] > hi ? k[l] : hi;
+    }
+    for (unsigned l = 0; l < Tr::lanes; ++l)
+      counts[t[l]]++;
+  }
+  for (; i < n; ++i) {
+    U k = key(a[i]);
+    counts[Tr::tick(k)]++;
+    lo = k < lo ? k : lo;
+    hi = k > hi ? k : hi;
+  }
+}
+
+// Range rebasing: keys packed in a narrow band far from zero (epoch
+// timestamps, dense IDs) all share one tick. Ticking key - lo instead lets
+// the buckets split the actual spread; subtracting the minimum already
+// clears every bit the keys have in common above it.
+template <class Tr, class U> bool rebase_pays(U lo, U hi) {
+  return Tr::tick(U(hi - lo)) < Tr::tick(hi);
+}
+
+template <unsigned Flags, bool Plain, class T, class KeyFn>
+bool small_sort(T *a, std::size_t n, KeyFn &key) {
+  using Tr = key_traits<key_of<T, KeyFn>>;
+
+  if constexpr (Plain || (Flags & unstable)) {
+    if (n <= Tr::network_max) {
+      if (n >= 2)
+        network_sort<Tr::network_max>(a, n, key);
+      return true;
+    }
+  }
+  if (n <= Tr::insertion_max) {
+    insertion_sort(a, n, key);
+    return true;
+  }
+  return false;
+}
+
+// Scatters by tick with the histogram in counts, then refines each bucket
+// back into keys.
+template <class Tr, class T, class KeyFn>
+void bucket_sort(T *keys, T *scratch, std::size_t n,
+                 const std::size_t *counts, KeyFn &key) {
+  std::size_t offsets[Tr::ticks];
+  std::size_t cursor[Tr::ticks];
+  std::size_t sum = 0;
+  for (unsigned t = 0; t < Tr::ticks; ++t) {
+    offsets[t] = cursor[t] = sum;
+    sum += counts[t];
+  }
+
+  // Stable scatter by tick
+  for (std::size_t i = 0; i < n; ++i)
+    scratch[cursor[Tr::tick(key(keys[i]))]++] = keys[i];
+
+  // Refine each bucket back into keys
+  for (unsigned t = 0; t < Tr::ticks; ++t)
+    if (counts[t])
+      refine_bucket<Tr>(&scratch[offsets[t]], &keys[offsets[t]], counts[t], t,
+                        key);
+}
+
+// Sequential engine for n > insertion_max; scratch must hold n elements.
+template <unsigned Flags, bool Plain, class T, class KeyFn>
+void tick_sort(T *keys, T *scratch, std::size_t n, KeyFn &key) {
+  using U = key_of<T, KeyFn>;
+  using Tr = key_traits<U>;
+  std::size_t counts[Tr::ticks] = {};
+
+  if constexpr (!(Flags & no_rebase)) {
+    U lo = key(keys[0]), hi = lo;
+    tick_histogram<Tr>(keys, n, counts, key, lo, hi);
+    if (lo == hi)
+      return; // All keys equal
+    if (rebase_pays<Tr>(lo, hi)) {
+      auto rebased = [&key, lo](const T &r) { return U(key(r) - lo); };
+      std::fill_n(counts, Tr::ticks, 0);
+      tick_histogram<Tr>(keys, n, counts, rebased);
+      bucket_sort<Tr>(keys, scratch, n, counts, rebased);
+      return;
+    }
+  } else {
+    tick_histogram<Tr>(keys, n, counts, key);
+  }
+  bucket_sort<Tr>(keys, scratch, n, counts, key);
+}
+
+// Runs fn(0..team-1), worker 0 on the calling thread. Workers that cannot
+// be spawned run inline, so the result never depends on thread limits.
+template <class Fn> void run_team(unsigned team, Fn &&fn) {
+  std::vector<std::thread> workers;
+  unsigned w = 1;
+
+  workers.reserve(team);
+  try {
+    for (; w < team; ++w)
+      workers.emplace_back(std::ref(fn), w);
+  } catch (const std::system_error &) {
+  }
+  for (unsigned rest = w; rest < team; ++rest)
+    fn(rest);
+  fn(0);
+  for (auto &t : workers)
+    t.join();
+}
+
+// Keys [lo, hi) of worker w's share of n.
+inline void team_slice(std::size_t n, unsigned team, unsigned w,
+                       std::size_t &lo, std::size_t &hi) {
+  lo = n * w / team;
+  hi = n * (w + 1) / team;
+}
+
+// Parallel scatter and refinement from per-worker tick histograms, which
+// become the workers' private write cursors.
+template <class Tr, class T, class KeyFn>
+void parallel_bucket_sort(T *keys, T *scratch, std::size_t n, unsigned team,
+                          std::vector<std::size_t> &hist, KeyFn &key) {
+  std::size_t offsets[Tr::ticks + 1];
+  std::size_t sum = 0;
+  for (unsigned t = 0; t < Tr::ticks; ++t) {
+    offsets[t] = sum;
+    for (unsigned w = 0; w < team; ++w) {
+      std::size_t c = hist[w * Tr::ticks + t];
+      hist[w * Tr::ticks + t] = sum;
+      sum += c;
+    }
+  }
+  offsets[Tr::ticks] = sum;
+
+  run_team(team, [&](unsigned w) {
+    std::size_t lo, hi;
+    std::size_t *cursor = &hist[w * Tr::ticks];
+    team_slice(n, team, w, lo, hi);
+    for (std::size_t i = lo; i < hi; ++i)
+      scratch[cursor[Tr::tick(key(keys[i]))]++] = keys[i];
+  });
+
+  // Largest buckets first so the tail of the schedule is short
+  unsigned order[Tr::ticks];
+  for (unsigned t = 0; t < Tr::ticks; ++t)
+    order[t] = t;
+  std::sort(order, order + Tr::ticks, [&](unsigned a, unsigned b) {
+    return offsets[a + 1] - offsets[a] > offsets[b + 1] - offsets[b];
+  });
+
+  std::atomic<unsigned> next{0};
+  run_team(team, [&](unsigned) {
+    for (unsigned i; (i = next.fetch_add(1)) < Tr::ticks;) {
+      unsigned t = order[i];
+      std::size_t len = offsets[t + 1] - offsets[t];
+      if (len)
+        refine_bucket<Tr>(&scratch[offsets[t]], &keys[offsets[t]], len, t,
+                          key);
+    }
+  });
+}
+
+template <unsigned Flags, bool Plain, class T, class KeyFn>
+void parallel_tick_sort(T *keys, T *scratch, std::size_t n, unsigned threads,
+                        KeyFn &key) {
+  using U = key_of<T, KeyFn>;
+  using Tr = key_traits<U>;
+
+  if (threads == 0)
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  unsigned team = (unsigned)std::min<std::size_t>(threads,
+                                                  n / Tr::parallel_min);
+  if (team <= 1) {
+    tick_sort<Flags, Plain>(keys, scratch, n, key);
+    return;
+  }
+
+  // Per-worker histograms, each with the bounds of its slice
+  std::vector<std::size_t> hist(std::size_t(team) * Tr::ticks);
+  std::vector<U> lows(team), highs(team);
+  run_team(team, [&](unsigned w) {
+    std::size_t lo, hi;
+    team_slice(n, team, w, lo, hi);
+    if constexpr (!(Flags & no_rebase)) {
+      lows[w] = highs[w] = key(keys[lo]);
+      tick_histogram<Tr>(&keys[lo], hi - lo, &hist[w * Tr::ticks], key,
+                         lows[w], highs[w]);
+    } else {
+      tick_histogram<Tr>(&keys[lo], hi - lo, &hist[w * Tr::ticks], key);
+    }
+  });
+
+  if constexpr (!(Flags & no_rebase)) {
+    U low = *std::min_element(lows.begin(), lows.end());
+    U high = *std::max_element(highs.begin(), highs.end());
+    if (low == high)
+      return; // All keys equal
+    if (rebase_pays<Tr>(low, high)) {
+      auto rebased = [&key, low](const T &r) { return U(key(r) - low); };
+      std::fill(hist.begin(), hist.end(), 0);
+      run_team(team, [&](unsigned w) {
+        std::size_t lo, hi;
+        team_slice(n, team, w, lo, hi);
+        tick_histogram<Tr>(&keys[lo], hi - lo, &hist[w * Tr::ticks],
+                           rebased);
+      });
+      parallel_bucket_sort<Tr>(keys, scratch, n, team, hist, rebased);
+      return;
+    }
+  }
+  parallel_bucket_sort<Tr>(keys, scratch, n, team, hist, key);
+}
+
+template <unsigned Flags, bool Plain, class T, class KeyFn>
+void run_engine(T *keys, std::size_t n, unsigned threads, KeyFn &key) {
+  auto scratch = std::make_unique_for_overwrite<T[]>(n);
+  if (threads == 1)
+    tick_sort<Flags, Plain>(keys, scratch.get(), n, key);
+  else
+    parallel_tick_sort<Flags, Plain>(keys, scratch.get(), n, threads, key);
+}
+
+template <unsigned Flags, bool Plain, class T, class KeyFn>
+void sort_span(std::span<T> keys, unsigned threads, KeyFn key) {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "overflow::sort needs trivially copyable elements");
+  std::size_t n = keys.size();
+  if (n < 2)
+    return;
+  if (small_sort<Flags, Plain>(keys.data(), n, key))
+    return;
+  run_engine<Flags, Plain>(keys.data(), n, threads, key);
+}
+
+template <unsigned Flags, class K> auto plain_key() {
+  return [](const K &k) { return key_traits<K>::template encode<Flags>(k); };
+}
+
+template <unsigned Flags, class T, class Proj> auto projected_key(Proj &proj) {
+  using K = std::remove_cvref_t<std::invoke_result_t<Proj &, const T &>>;
+  return [&proj](const T &r) {
+    return key_traits<K>::template encode<Flags>(std::invoke(proj, r));
+  };
+}
+
+template <class R>
+using value_t = std::remove_cv_t<std::ranges::range_value_t<R>>;
+
+template <class R> auto span_of(R &&r) {
+  return std::span(std::ranges::data(r), std::ranges::size(r));
+}
+
+} // namespace detail
+
+template <class R>
+concept key_range = std::ranges::contiguous_range<R> &&
+                    std::ranges::sized_range<R> &&
+                    sort_key<detail::value_t<R>>;
+
+template <class R, class Proj>
+concept record_range =
+    std::ranges::contiguous_range<R> && std::ranges::sized_range<R> &&
+    std::invocable<Proj &, const detail::value_t<R> &> &&
+    sort_key<std::remove_cvref_t<
+        std::invoke_result_t<Proj &, const detail::value_t<R> &>>>;
+
+// Sorts a contiguous range of keys in place.
+template <unsigned Flags = ascending, key_range R> void sort(R &&keys) {
+  using K = detail::value_t<R>;
+  detail::sort_span<Flags, true>(detail::span_of(keys), 1,
+                                 detail::plain_key<Flags, K>());
+}
+
+template <unsigned Flags = ascending, std::contiguous_iterator It>
+  requires sort_key<std::iter_value_t<It>>
+void sort(It first, It last) {
+  sort<Flags>(std::span(std::to_address(first), std::size_t(last - first)));
+}
+
+// Sorts records by proj(record); stable unless `unstable` is set.
+template <unsigned Flags = ascending, class R, class Proj>
+  requires record_range<R, Proj>
+void sort(R &&records, Proj proj) {
+  using T = detail::value_t<R>;
+  detail::sort_span<Flags, false>(detail::span_of(records), 1,
+                                  detail::projected_key<Flags, T>(proj));
+}
+
+template <unsigned Flags = ascending, key_range R>
+void sort(const sequenced_policy &, R &&keys) {
+  sort<Flags>(keys);
+}
+
+template <unsigned Flags = ascending, class R, class Proj>
+  requires record_range<R, Proj>
+void sort(const sequenced_policy &, R &&records, Proj proj) {
+  sort<Flags>(records, std::move(proj));
+}
+
+// Parallel engine: per-worker histograms and scatter, then buckets refined
+// largest first across the team. Falls back to one thread below
+// key_traits::parallel_min keys per worker.
+template <unsigned Flags = ascending, key_range R>
+void sort(const parallel_policy &policy, R &&keys) {
+  using K = detail::value_t<R>;
+  detail::sort_span<Flags, true>(detail::span_of(keys), policy.threads,
+                                 detail::plain_key<Flags, K>());
+}
+
+template <unsigned Flags = ascending, std::contiguous_iterator It>
+  requires sort_key<std::iter_value_t<It>>
+void sort(const parallel_policy &policy, It first, It last) {
+  sort<Flags>(policy,
+              std::span(std::to_address(first), std::size_t(last - first)));
+}
+
+template <unsigned Flags = ascending, class R, class Proj>
+  requires record_range<R, Proj>
+void sort(const parallel_policy &policy, R &&records, Proj proj) {
+  using T = detail::value_t<R>;
+  detail::sort_span<Flags, false>(detail::span_of(records), policy.threads,
+                                  detail::projected_key<Flags, T>(proj));
+}
+
+} // namespace overflow
+
+#endif
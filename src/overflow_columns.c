@@ -0,0 +1,253 @@
+/**
+ * @file overflow_columns.c
+ * @brief Lexicographic multi-column sort for columnar tables.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include "overflow_columns.h"
+#include "overflow_tick.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define DIGIT_BITS 8
+#define DIGIT_BINS (1u << DIGIT_BITS)
+#define PREFETCH_AHEAD 16 // Rows ahead of the gather cursor
+
+// Reads row i of a key column as an order-preserving unsigned value.
+static inline uint64_t encode_key(const overflow_column *col, size_t i) {
+  unsigned bits = col->width * 8;
+  uint64_t top = 1ull << (bits - 1);
+  uint64_t mask = bits == 64 ? ~0ull : (1ull << bits) - 1;
+  uint64_t v;
+
+  switch (col->width) {
+  case 1:
+    v = ((const uint8_t *)col->data)[i];
+    break;
+  case 2:
+    v = ((const uint16_t *)col->data)[i];
+    break;
+  case 4:
+    v = ((const uint32_t *)col->data)[i];
+    break;
+  default:
+    v = ((const uint64_t *)col->data)[i];
+    break;
+  }
+
+  if (col->flags & OVERFLOW_COL_FLOAT)
+    v = (v & top) ? ~v & mask : v | top;
+  else if (col->flags & OVERFLOW_COL_SIGNED)
+    v ^= top;
+  if (col->flags & OVERFLOW_COL_DESCENDING)
+    v = ~v & mask;
+  return v;
+}
+
+// Digit histograms of one column, counted in natural row order. Returns
+// the number of digits that actually need a scatter pass, listed in
+// `digits` least significant first.
+static unsigned plan_digits(const overflow_column *col, size_t n,
+                            size_t (*count)[DIGIT_BINS], unsigned *digits) {
+  unsigned ndigits = col->width;
+  unsigned top_tick = 0;
+  unsigned used = 0;
+
+  memset(count, 0, ndigits * sizeof(*count));
+  for (size_t i = 0; i < n; ++i) {
+    uint64_t v = encode_key(col, i);
+    unsigned t = overflow_tick_u64(v);
+    top_tick = t > top_tick ? t : top_tick;
+    for (unsigned d = 0; d < ndigits; ++d)
+      count[d][(v >> (d * DIGIT_BITS)) & (DIGIT_BINS - 1)]++;
+  }
+
+  // Digits wholly above the highest tick are zero in every row
+  for (unsigned d = 0; d < ndigits && d * DIGIT_BITS < top_tick; ++d) {
+    int populated = 0;
+    for (unsigned b = 0; b < DIGIT_BINS && populated < 2; ++b)
+      populated += count[d][b] != 0;
+    if (populated > 1)
+      digits[used++] = d;
+  }
+  return used;
+}
+
+// Stable LSD passes over one column's planned digits, carrying keys of
+// type `ktype` next to the row indices. The first pass reads the keys
+// straight from the column in the current row order, so the column is
+// never gathered on its own.
+#define SCATTER_COLUMN(ktype)                                                  \
+  do {                                                                         \
+    ktype *kin = key, *kout = key_tmp;                                         \
+    for (unsigned u = 0; u < used; ++u) {                                      \
+      unsigned shift = digits[u] * DIGIT_BITS;                                 \
+      size_t *cursor = count[digits[u]];                                       \
+      size_t sum = 0;                                                          \
+      for (unsigned b = 0; b < DIGIT_BINS; ++b) {                              \
+        size_t c2 = cursor[b];                                                 \
+        cursor[b] = sum;                                                       \
+        sum += c2;                                                             \
+      }                                                                        \
+      for (size_t i = 0; i < n; ++i) {                                         \
+        ktype k = u ? kin[i] : (ktype)encode_key(col, idx[i]);                 \
+        size_t pos = cursor[(k >> shift) & (DIGIT_BINS - 1)]++;                \
+        kout[pos] = k;                                                         \
+        idx_tmp[pos] = idx[i];                                                 \
+      }                                                                        \
+      ktype *kt = kin;                                                         \
+      kin = kout;                                                              \
+      kout = kt;                                                               \
+      uint32_t *it = idx;                                                      \
+      idx = idx_tmp;                                                           \
+      idx_tmp = it;                                                            \
+    }                                                                          \
+  } while (0)
+
+static int key_width_ok(unsigned width) {
+  return width == 1 || width == 2 || width == 4 || width == 8;
+}
+
+int overflow_order_columns(const overflow_column *keys, size_t nkeys,
+                           size_t n, uint32_t *perm) {
+  if (n > UINT32_MAX)
+    return -1;
+  for (size_t c = 0; c < nkeys; ++c)
+    if (!key_width_ok(keys[c].width))
+      return -1;
+  for (size_t i = 0; i < n; ++i)
+    perm[i] = (uint32_t)i;
+  if (n < 2 || nkeys == 0)
+    return 0;
+
+  // Key scratch is sized for 64-bit columns; narrower ones carry uint32_t
+  void *key = malloc(n * sizeof(uint64_t));
+  void *key_tmp = malloc(n * sizeof(uint64_t));
+  uint32_t *idx_tmp = malloc(n * sizeof(uint32_t));
+  if (!key || !key_tmp || !idx_tmp) {
+    free(key);
+    free(key_tmp);
+    free(idx_tmp);
+    return -1;
+  }
+
+  uint32_t *idx = perm;
+  for (size_t c = nkeys; c-- > 0;) {
+    const overflow_column *col = &keys[c];
+    size_t count[8][DIGIT_BINS];
+    unsigned digits[8];
+    unsigned used = plan_digits(col, n, count, digits);
+
+    // A column with no varying digit leaves the order unchanged
+    if (col->width == 8)
+      SCATTER_COLUMN(uint64_t);
+    else
+      SCATTER_COLUMN(uint32_t);
+  }
+
+  // An odd number of passes leaves the result in the scratch index array
+  if (idx != perm) {
+    memcpy(perm, idx, n * sizeof(uint32_t));
+    idx_tmp = idx;
+  }
+  free(key);
+  free(key_tmp);
+  free(idx_tmp);
+  return 0;
+}
+
+#define GATHER(type)                                                           \
+  do {                                                                         \
+    const type *src = col->data;                                               \
+    type *dst = tmp;                                                           \
+    for (size_t i = 0; i < n; ++i) {                                           \
+      if (i + PREFETCH_AHEAD < n)                                              \
+        __builtin_prefetch(&src[perm[i + PREFETCH_AHEAD]]);                    \
+      dst[i] = src[perm[i]];                                                   \
+    }                                                                          \
+  } while (0)
+
+// Permutes one column through tmp, which holds n * col->width bytes.
+static void permute_with(const overflow_column *col, const uint32_t *perm,
+                         size_t n, void *tmp) {
+  switch (col->width) {
+  case 1:
+    GATHER(uint8_t);
+    break;
+  case 2:
+    GATHER(uint16_t);
+    break;
+  case 4:
+    GATHER(uint32_t);
+    break;
+  case 8:
+    GATHER(uint64_t);
+    break;
+  default: {
+    // Other payload widths move their bytes row by row
+    const uint8_t *src = col->data;
+    uint8_t *dst = tmp;
+    size_t w = col->width;
+    for (size_t i = 0; i < n; ++i) {
+      if (i + PREFETCH_AHEAD < n)
+        __builtin_prefetch(&src[perm[i + PREFETCH_AHEAD] * w]);
+      memcpy(&dst[i * w], &src[perm[i] * w], w);
+    }
+    break;
+  }
+  }
+  memcpy(col->data, tmp, n * col->width);
+}
+
+int overflow_permute_column(const overflow_column *col, const uint32_t *perm,
+                            size_t n) {
+  if (col->width == 0)
+    return -1;
+  void *tmp = malloc(n * col->width);
+  if (!tmp && n)
+    return -1;
+  permute_with(col, perm, n, tmp);
+  free(tmp);
+  return 0;
+}
+
+int overflow_sort_columns(const overflow_column *keys, size_t nkeys,
+                          const overflow_column *payload, size_t npayload,
+                          size_t n) {
+  size_t max_width = 0;
+
+  if (n > UINT32_MAX)
+    return -1;
+  for (size_t c = 0; c < nkeys; ++c) {
+    if (!key_width_ok(keys[c].width))
+      return -1;
+    max_width = keys[c].width > max_width ? keys[c].width : max_width;
+  }
+  for (size_t c = 0; c < npayload; ++c) {
+    if (payload[c].width == 0)
+      return -1;
+    max_width = payload[c].width > max_width ? payload[c].width : max_width;
+  }
+
+  // All scratch is taken up front, so a failure leaves the table untouched
+  uint32_t *perm = malloc(n * sizeof(uint32_t));
+  void *tmp = malloc(n * max_width);
+  if ((!perm || !tmp) && n) {
+    free(perm);
+    free(tmp);
+    return -1;
+  }
+
+  int rc = overflow_order_columns(keys, nkeys, n, perm);
+  for (size_t c = 0; rc == 0 && c < nkeys; ++c)
+    permute_with(&keys[c], perm, n, tmp);
+  for (size_t c = 0; rc == 0 && c < npayload; ++c)
+    permute_with(&payload[c], perm, n, tmp);
+  free(perm);
+  free(tmp);
+  return rc;
+}
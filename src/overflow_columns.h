@@ -0,0 +1,54 @@
+/**
+ * @file overflow_columns.h
+ * @brief Lexicographic multi-column sort for columnar tables.
+ *
+ * Rows are ordered by several key columns of mixed widths, most significant
+ * first, without packing them into one wide key. The columns are processed
+ * least significant first; each one is a stable LSD radix over its bytes
+ * that carries the row permutation along. Digit histograms do not depend
+ * on row order, so every column is counted once in its natural order;
+ * digits above the column's highest tick, or shared by every row, are never
+ * scattered, and a constant column costs one read. The finished permutation
+ * is then applied to key and payload columns with a prefetching gather.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#ifndef OVERFLOW_COLUMNS_H
+#define OVERFLOW_COLUMNS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Key column flags
+#define OVERFLOW_COL_SIGNED 0x1     // Two's complement integers
+#define OVERFLOW_COL_FLOAT 0x2      // IEEE float (width 4) or double (8)
+#define OVERFLOW_COL_DESCENDING 0x4 // Largest first
+
+typedef struct {
+  void *data;     // n values
+  unsigned width; // Bytes per value: 1, 2, 4 or 8; payloads may use any
+  unsigned flags; // OVERFLOW_COL_* (ignored for payload columns)
+} overflow_column;
+
+// Stable row order by keys[0], then keys[1], ...: perm[i] is the row that
+// belongs at position i. Returns 0, or -1 if a key width is not 1, 2, 4
+// or 8, scratch allocation fails or n exceeds UINT32_MAX.
+int overflow_order_columns(const overflow_column *keys, size_t nkeys,
+                           size_t n, uint32_t *perm);
+
+// Reorders one column in place so that row perm[i] moves to position i.
+// Returns 0, or -1 for a zero width or if scratch allocation fails.
+int overflow_permute_column(const overflow_column *col, const uint32_t *perm,
+                            size_t n);
+
+// Sorts the rows of a table by its key columns, reordering the key and
+// payload columns in place. Returns 0, or -1 on failure as above, in
+// which case no column has been reordered.
+int overflow_sort_columns(const overflow_column *keys, size_t nkeys,
+                          const overflow_column *payload, size_t npayload,
+                          size_t n);
+
+#endif
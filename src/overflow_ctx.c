@@ -0,0 +1,96 @@
+/**
+ * @file overflow_ctx.c
+ * @brief Reusable sort context owning aligned scratch arenas.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include "overflow_ctx.h"
+#include "overflow_engine.h"
+#include "overflow_hugepage.h"
+#include "overflow_parallel.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+void overflow_ctx_init(overflow_sort_ctx *ctx) {
+  memset(ctx, 0, sizeof(*ctx));
+  ctx->threads = 1;
+}
+
+static void arena_release(overflow_arena *a) {
+  if (a->mapped)
+    overflow_huge_free(a->ptr, a->mapped);
+  else
+    free(a->ptr);
+}
+
+void overflow_ctx_free(overflow_sort_ctx *ctx) {
+  for (int i = 0; i < OVERFLOW_CTX_ARENAS; ++i)
+    arena_release(&ctx->arenas[i]);
+  memset(ctx->arenas, 0, sizeof(ctx->arenas));
+}
+
+void *overflow_ctx_arena(overflow_sort_ctx *ctx, unsigned arena, size_t bytes) {
+  overflow_arena *a = &ctx->arenas[arena];
+
+  if (bytes <= a->bytes)
+    return a->ptr;
+
+  // Double on growth so a slowly rising input size settles quickly
+  size_t want = a->bytes * 2 > bytes ? a->bytes * 2 : bytes;
+  want = (want + OVERFLOW_CTX_ALIGN - 1) & ~(size_t)(OVERFLOW_CTX_ALIGN - 1);
+
+  void *ptr;
+  size_t mapped = 0;
+  if (ctx->pages != OVERFLOW_PAGES_SMALL && want >= OVERFLOW_CTX_HUGE_MIN) {
+    ptr = overflow_huge_alloc(want, ctx->pages, 0, &mapped);
+    if (!ptr)
+      return NULL;
+    want = mapped;
+  } else if (posix_memalign(&ptr, OVERFLOW_CTX_ALIGN, want) != 0) {
+    return NULL;
+  }
+
+  arena_release(a);
+  a->ptr = ptr;
+  a->bytes = want;
+  a->mapped = mapped;
+  ctx->allocations++;
+  return ptr;
+}
+
+int overflow_ctx_reserve(overflow_sort_ctx *ctx, size_t n) {
+  return overflow_ctx_arena(ctx, OVERFLOW_ARENA_SCRATCH,
+                            n * sizeof(uint32_t)) ? 0 : -1;
+}
+
+size_t overflow_ctx_footprint(const overflow_sort_ctx *ctx) {
+  size_t total = 0;
+  for (int i = 0; i < OVERFLOW_CTX_ARENAS; ++i)
+    total += ctx->arenas[i].bytes;
+  return total;
+}
+
+int overflow_sort_ctx_u32(overflow_sort_ctx *ctx, uint32_t *keys, size_t n) {
+  if (n <= OVERFLOW_INSERTION_MAX) {
+    overflow_tick_sort_u32(keys, n, NULL);
+    return 0;
+  }
+
+  uint32_t *scratch =
+      overflow_ctx_arena(ctx, OVERFLOW_ARENA_SCRATCH, n * sizeof(uint32_t));
+  if (!scratch)
+    return -1;
+
+  overflow_parallel_opts opts = {.threads = ctx->threads};
+  if (ctx->pages != OVERFLOW_PAGES_SMALL && n >= OVERFLOW_CTX_PARALLEL_MIN)
+    opts.flags |= OVERFLOW_STREAM_OUTPUT;
+
+  if (ctx->threads != 1 && n >= OVERFLOW_CTX_PARALLEL_MIN)
+    return overflow_sort_parallel_opts_u32(keys, n, scratch, &opts);
+  overflow_tick_sort_flags_u32(keys, n, scratch, opts.flags);
+  return 0;
+}
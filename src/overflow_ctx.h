@@ -0,0 +1,74 @@
+/**
+ * @file overflow_ctx.h
+ * @brief Reusable sort context owning aligned scratch arenas.
+ *
+ * A context keeps its scratch between calls and only grows it (geometrically)
+ * when a larger input arrives, so repeated sorts of similar sizes allocate
+ * nothing in steady state. Contexts hold no global state: use one per thread
+ * and sort concurrently.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#ifndef OVERFLOW_CTX_H
+#define OVERFLOW_CTX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "overflow_hugepage.h"
+#include "overflow_parallel.h"
+
+#define OVERFLOW_CTX_ALIGN 64 // Cache-line aligned arenas
+#define OVERFLOW_CTX_ARENAS 4
+
+// Arena slots; engines that need several buffers use distinct slots
+enum {
+  OVERFLOW_ARENA_SCRATCH = 0, // Ping-pong key buffer
+  OVERFLOW_ARENA_AUX = 1,     // Engine-specific side tables
+  OVERFLOW_ARENA_USER0 = 2,   // Free for callers
+  OVERFLOW_ARENA_USER1 = 3
+};
+
+typedef struct {
+  void *ptr;
+  size_t bytes;
+  size_t mapped; // Nonzero when the arena is an mmap of this length
+} overflow_arena;
+
+typedef struct {
+  overflow_arena arenas[OVERFLOW_CTX_ARENAS];
+  unsigned threads;   // Workers for large inputs (1 = never spawn, 0 = all)
+  int pages;          // OVERFLOW_PAGES_* mode for large arenas
+  size_t allocations; // Arena allocations made so far
+} overflow_sort_ctx;
+
+// Large inputs switch to the parallel engine when ctx->threads != 1
+#define OVERFLOW_CTX_PARALLEL_MIN (1u << 20)
+
+// Large-array mode: with ctx->pages != OVERFLOW_PAGES_SMALL, arenas of at
+// least this size go on prefaulted huge pages and sorts of at least
+// OVERFLOW_CTX_PARALLEL_MIN keys write their final copies with streaming
+// stores. Prefaulting uses every online CPU regardless of ctx->threads.
+#define OVERFLOW_CTX_HUGE_MIN (8u << 20)
+
+void overflow_ctx_init(overflow_sort_ctx *ctx);
+void overflow_ctx_free(overflow_sort_ctx *ctx);
+
+// Returns an arena of at least `bytes`, growing it if needed (contents are
+// not preserved across growth). Returns NULL if allocation fails.
+void *overflow_ctx_arena(overflow_sort_ctx *ctx, unsigned arena, size_t bytes);
+
+// Preallocates the scratch needed to sort n uint32_t keys.
+int overflow_ctx_reserve(overflow_sort_ctx *ctx, size_t n);
+
+// Total bytes currently held by the context's arenas.
+size_t overflow_ctx_footprint(const overflow_sort_ctx *ctx);
+
+// Sorts keys in place using the context's scratch. Returns 0 on success,
+// -1 if the scratch can't be grown.
+int overflow_sort_ctx_u32(overflow_sort_ctx *ctx, uint32_t *keys, size_t n);
+
+#endif
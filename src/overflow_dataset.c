@@ -0,0 +1,370 @@
+/**
+ * @file overflow_dataset.c
+ * @brief Seeded benchmark datasets: fast generators and an mmap cache.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#define _GNU_SOURCE
+#include "overflow_dataset.h"
+#include "overflow_parallel.h"
+
+#include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define LANES 2 // SSE2 width, so the vectors stay in registers on any x86-64
+#define BLOCK_KEYS 65536 // Keys per independently seeded block
+#define PATH_MAX_LEN 512
+
+// Series coefficients, highest order first
+static const double LOG_C[] = {1.0 / 19, 1.0 / 17, 1.0 / 15, 1.0 / 13,
+                               1.0 / 11, 1.0 / 9,  1.0 / 7,  1.0 / 5,
+                               1.0 / 3,  1.0};
+static const double EXP_C[] = {1.0 / 6227020800, 1.0 / 479001600,
+                               1.0 / 39916800,   1.0 / 3628800,
+                               1.0 / 362880,     1.0 / 40320,
+                               1.0 / 5040,       1.0 / 720,
+                               1.0 / 120,        1.0 / 24,
+                               1.0 / 6,          1.0 / 2,
+                               1.0,              1.0};
+static const double SIN_C[] = {1.0 / 355687428096000, 1.0 / 1307674368000,
+                               1.0 / 6227020800,      1.0 / 39916800,
+                               1.0 / 362880,          1.0 / 5040,
+                               1.0 / 120,             1.0 / 6,
+                               1.0};
+static const double COS_C[] = {1.0 / 20922789888000, 1.0 / 87178291200,
+                               1.0 / 479001600,      1.0 / 3628800,
+                               1.0 / 40320,          1.0 / 720,
+                               1.0 / 24,             1.0 / 2,
+                               1.0};
+
+#define COUNT(a) (sizeof(a) / sizeof(a[0]))
+
+typedef uint64_t vu64 __attribute__((vector_size(LANES * 8)));
+typedef int64_t vi64 __attribute__((vector_size(LANES * 8)));
+typedef double vf64 __attribute__((vector_size(LANES * 8)));
+
+static uint64_t splitmix64(uint64_t *x) {
+  uint64_t z = (*x += 0x9e3779b97f4a7c15ull);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+  return z ^ (z >> 31);
+}
+
+void overflow_rng_seed(overflow_rng *rng, uint64_t seed) {
+  for (int i = 0; i < 4; ++i)
+    rng->s[i] = splitmix64(&seed);
+}
+
+// xoshiro256** streams side by side, one per lane.
+typedef struct {
+  vu64 s0, s1, s2, s3;
+} VecRng;
+
+static void vec_rng_seed(VecRng *v, uint64_t seed, uint64_t block) {
+  uint64_t x = seed ^ (block * 0xd1342543de82ef95ull);
+  for (int l = 0; l < LANES; ++l) {
+    v->s0[l] = splitmix64(&x);
+    v->s1[l] = splitmix64(&x);
+    v->s2[l] = splitmix64(&x);
+    v->s3[l] = splitmix64(&x);
+  }
+}
+
+static inline vu64 vec_rng_next(VecRng *v) {
+  vu64 x = (v->s1 << 2) + v->s1; // * 5
+  vu64 r = x << 7 | x >> 57;
+  vu64 result = (r << 3) + r; // * 9
+  vu64 t = v->s1 << 17;
+
+  v->s2 ^= v->s0;
+  v->s3 ^= v->s1;
+  v->s1 ^= v->s2;
+  v->s0 ^= v->s3;
+  v->s2 ^= t;
+  v->s3 = v->s3 << 45 | v->s3 >> 19;
+  return result;
+}
+
+static inline vf64 splat(double x) {
+  return (vf64){0} + x;
+}
+
+static inline vf64 select_f64(vi64 mask, vf64 a, vf64 b) {
+  return (vf64)(((vi64)a & mask) | ((vi64)b & ~mask));
+}
+
+// Uniform in (0, 1] with 53 random bits.
+static inline vf64 unit_open(vu64 bits) {
+  vi64 m = (vi64)(bits >> 11) + 1;
+  return __builtin_convertvector(m, vf64) * 0x1p-53;
+}
+
+// Natural log for x > 0: split off the exponent, then the atanh series on
+// the mantissa in [sqrt(1/2), sqrt(2)); ten terms reach double precision.
+static inline vf64 vec_log(vf64 x) {
+  vi64 bits = (vi64)x;
+  vi64 e = ((bits >> 52) & 0x7ff) - 1022;
+  vf64 m = (vf64)((bits & 0x000fffffffffffffll) | 0x3fe0000000000000ll);
+  vi64 small = m < M_SQRT1_2;
+
+  m = select_f64(small, m * 2, m);
+  e -= small & 1;
+
+  vf64 s = (m - 1) / (m + 1);
+  vf64 s2 = s * s;
+  vf64 p = splat(LOG_C[0]);
+  for (size_t i = 1; i < COUNT(LOG_C); ++i)
+    p = p * s2 + LOG_C[i];
+  return 2 * s * p + __builtin_convertvector(e, vf64) * M_LN2;
+}
+
+// e^x for x in [-708, 709]: x = k ln2 + r, Taylor series on |r| <= ln2/2.
+static inline vf64 vec_exp(vf64 x) {
+  vf64 lo = splat(-708);
+  vf64 hi = splat(709);
+  x = select_f64(x < lo, lo, x);
+  x = select_f64(x > hi, hi, x);
+
+  vf64 y = x * M_LOG2E + 0.5;
+  vi64 k = __builtin_convertvector(y, vi64);
+  k -= (__builtin_convertvector(k, vf64) > y) & 1; // floor for negatives
+  vf64 r = x - __builtin_convertvector(k, vf64) * M_LN2;
+
+  vf64 p = splat(EXP_C[0]);
+  for (size_t i = 1; i < COUNT(EXP_C); ++i)
+    p = p * r + EXP_C[i];
+  return p * (vf64)((k + 1023) << 52);
+}
+
+// cos and sin of 2 pi u for u in [0, 1): quarter-turn reduction, then the
+// Taylor series around pi/4.
+static inline void vec_sincos_turn(vf64 u, vf64 *c, vf64 *s) {
+  vf64 t = u * 4;
+  vi64 q = __builtin_convertvector(t, vi64);
+  vf64 f = (t - __builtin_convertvector(q, vf64)) * M_PI_2 - M_PI_4;
+  vf64 f2 = f * f;
+
+  vf64 sp = splat(SIN_C[0]);
+  vf64 cp = splat(COS_C[0]);
+  for (size_t i = 1; i < COUNT(SIN_C); ++i) {
+    sp = SIN_C[i] - sp * f2;
+    cp = COS_C[i] - cp * f2;
+  }
+  sp *= f;
+
+  // Angle within the quarter is pi/4 + f; rotate by q quarter turns
+  vf64 sq = (sp + cp) * M_SQRT1_2;
+  vf64 cq = (cp - sp) * M_SQRT1_2;
+  vi64 odd = -(q & 1);
+  vi64 back = -(q >> 1); // Quarters 2 and 3 negate both
+  vf64 cv = select_f64(odd, -sq, cq);
+  vf64 sv = select_f64(odd, cq, sq);
+  *c = select_f64(back, -cv, cv);
+  *s = select_f64(back, -sv, sv);
+}
+
+static inline void store_clamped(uint32_t *out, vf64 v, double max) {
+  for (int l = 0; l < LANES; ++l) {
+    double x = v[l];
+    out[l] = x <= 0 ? 0 : x >= max ? (uint32_t)max : (uint32_t)x;
+  }
+}
+
+typedef struct {
+  uint32_t *keys;
+  size_t n;
+  const overflow_dataset_spec *spec;
+  size_t blocks;
+  unsigned threads;
+} GenJob;
+
+static void generate_block(const overflow_dataset_spec *spec, size_t block,
+                           uint32_t *out, size_t len) {
+  double max = spec->range ? spec->range - 1.0 : (double)UINT32_MAX;
+  double ranks = spec->range ? spec->range : 4294967296.0;
+  double q = 1 - spec->a;
+  double zipf_span = fabs(q) < 1e-9 ? log(ranks + 1) : pow(ranks + 1, q) - 1;
+  uint32_t tail[2 * LANES];
+  VecRng rng;
+
+  vec_rng_seed(&rng, spec->seed, block);
+  for (size_t i = 0; i < len; i += 2 * LANES) {
+    vu64 r0 = vec_rng_next(&rng);
+    vu64 r1 = vec_rng_next(&rng);
+    uint32_t *o = i + 2 * LANES <= len ? &out[i] : tail;
+
+    switch (spec->dist) {
+    case OVERFLOW_DIST_NORMAL:
+    case OVERFLOW_DIST_LOGNORMAL: {
+      // Box-Muller: one radius and angle give two deviates
+      vf64 radius = -2 * vec_log(unit_open(r0));
+      for (int l = 0; l < LANES; ++l)
+        radius[l] = sqrt(radius[l]);
+      vf64 c, s;
+      vec_sincos_turn(unit_open(r1) - 0x1p-53, &c, &s);
+      vf64 z0 = spec->a + spec->b * radius * c;
+      vf64 z1 = spec->a + spec->b * radius * s;
+      if (spec->dist == OVERFLOW_DIST_LOGNORMAL) {
+        z0 = vec_exp(z0);
+        z1 = vec_exp(z1);
+      }
+      store_clamped(o, z0 + 0.5, max);
+      store_clamped(o + LANES, z1 + 0.5, max);
+      break;
+    }
+    case OVERFLOW_DIST_ZIPF: {
+      // Inverse CDF of the continuous power law on [1, ranks + 1)
+      vf64 u[2] = {unit_open(r0), unit_open(r1)};
+      for (int h = 0; h < 2; ++h) {
+        vf64 x = fabs(q) < 1e-9 ? vec_exp(u[h] * zipf_span)
+                                : vec_exp(vec_log(1 + u[h] * zipf_span) / q);
+        store_clamped(o + h * LANES, x - 1, max);
+      }
+      break;
+    }
+    default: {
+      // Multiply-shift maps the top 32 bits onto [0, range)
+      for (int l = 0; l < LANES; ++l) {
+        uint64_t hi0 = r0[l] >> 32, hi1 = r1[l] >> 32;
+        o[l] = spec->range ? (uint32_t)(hi0 * spec->range >> 32)
+                           : (uint32_t)hi0;
+        o[LANES + l] = spec->range ? (uint32_t)(hi1 * spec->range >> 32)
+                                   : (uint32_t)hi1;
+      }
+      break;
+    }
+    }
+    if (o == tail)
+      memcpy(&out[i], tail, (len - i) * sizeof(uint32_t));
+  }
+}
+
+static void generate_worker(void *arg, unsigned id) {
+  GenJob *job = arg;
+  size_t first = job->blocks * id / job->threads;
+  size_t last = job->blocks * (id + 1) / job->threads;
+
+  for (size_t b = first; b < last; ++b) {
+    size_t lo = b * BLOCK_KEYS;
+    size_t len = job->n - lo < BLOCK_KEYS ? job->n - lo : BLOCK_KEYS;
+    generate_block(job->spec, b, &job->keys[lo], len);
+  }
+}
+
+void overflow_dataset_generate(uint32_t *keys, size_t n,
+                               const overflow_dataset_spec *spec,
+                               unsigned threads) {
+  GenJob job = {.keys = keys,
+                .n = n,
+                .spec = spec,
+                .blocks = (n + BLOCK_KEYS - 1) / BLOCK_KEYS};
+
+  if (threads == 0)
+    threads = overflow_parallel_threads();
+  if (threads > job.blocks)
+    threads = job.blocks ? (unsigned)job.blocks : 1;
+  job.threads = threads;
+  overflow_parallel_run(threads, generate_worker, &job);
+}
+
+static void cache_path(char *path, const char *dir, size_t n,
+                       const overflow_dataset_spec *spec) {
+  static const char *names[] = {"uniform", "normal", "lognormal", "zipf"};
+  const char *name =
+      spec->dist >= 0 && spec->dist <= OVERFLOW_DIST_ZIPF ? names[spec->dist]
+                                                          : "unknown";
+
+  // Parameters go in as hex floats so the name is exact
+  snprintf(path, PATH_MAX_LEN, "%s/%s-n%zu-s%llx-a%a-b%a-r%u.u32", dir, name,
+           n, (unsigned long long)spec->seed, spec->a, spec->b, spec->range);
+}
+
+static uint32_t *map_file(const char *path, size_t bytes) {
+  int fd = open(path, O_RDONLY);
+  struct stat st;
+
+  if (fd < 0)
+    return NULL;
+  if (fstat(fd, &st) != 0 || (size_t)st.st_size != bytes) {
+    close(fd);
+    return NULL;
+  }
+  void *p = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  return p == MAP_FAILED ? NULL : p;
+}
+
+// Generates into a temporary file next to `path` and renames it into
+// place, so concurrent runs never map a half-written dataset.
+static int write_cache(const char *path, size_t n,
+                       const overflow_dataset_spec *spec, unsigned threads) {
+  char tmp[PATH_MAX_LEN + 32];
+  size_t bytes = n * sizeof(uint32_t);
+
+  snprintf(tmp, sizeof(tmp), "%s.%ld.tmp", path, (long)getpid());
+  int fd = open(tmp, O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0)
+    return -1;
+  if (ftruncate(fd, (off_t)bytes) != 0) {
+    close(fd);
+    unlink(tmp);
+    return -1;
+  }
+  void *p = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (p == MAP_FAILED) {
+    unlink(tmp);
+    return -1;
+  }
+  overflow_dataset_generate(p, n, spec, threads);
+  munmap(p, bytes);
+  if (rename(tmp, path) != 0) {
+    unlink(tmp);
+    return -1;
+  }
+  return 0;
+}
+
+uint32_t *overflow_dataset_load(const char *dir, size_t n,
+                                const overflow_dataset_spec *spec,
+                                unsigned threads) {
+  size_t bytes = n * sizeof(uint32_t);
+
+  if (n == 0)
+    return NULL;
+  if (!dir)
+    dir = getenv("OVERFLOW_DATASET_DIR");
+
+  if (dir && *dir) {
+    char path[PATH_MAX_LEN];
+    cache_path(path, dir, n, spec);
+    uint32_t *keys = map_file(path, bytes);
+    if (keys)
+      return keys;
+    if (write_cache(path, n, spec, threads) == 0 &&
+        (keys = map_file(path, bytes)))
+      return keys;
+    // Unwritable cache: fall through to an uncached dataset
+  }
+
+  void *p = mmap(NULL, bytes, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (p == MAP_FAILED)
+    return NULL;
+  overflow_dataset_generate(p, n, spec, threads);
+  return p;
+}
+
+void overflow_dataset_release(uint32_t *keys, size_t n) {
+  if (keys)
+    munmap(keys, n * sizeof(uint32_t));
+}
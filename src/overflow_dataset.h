@@ -0,0 +1,76 @@
+/**
+ * @file overflow_dataset.h
+ * @brief Seeded benchmark datasets: fast generators and an mmap cache.
+ *
+ * Keys come from xoshiro256** streams, one per vector lane, with the
+ * transcendental parts of each distribution done as branch-free
+ * polynomials on GCC vector types. The output is split into fixed blocks
+ * whose streams are seeded from (seed, block), so a dataset is identical
+ * for any thread count and can be regenerated anywhere from its spec.
+ *
+ * overflow_dataset_load() keeps generated datasets as raw little-endian
+ * uint32_t files (n * 4 bytes, no header) and maps them on later runs.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#ifndef OVERFLOW_DATASET_H
+#define OVERFLOW_DATASET_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Distributions
+#define OVERFLOW_DIST_UNIFORM 0   // [0, range)
+#define OVERFLOW_DIST_NORMAL 1    // mean a, stddev b, clamped to the range
+#define OVERFLOW_DIST_LOGNORMAL 2 // exp(N(a, b)), clamped to the range
+#define OVERFLOW_DIST_ZIPF 3      // rank - 1 for ranks 1..range, exponent a
+
+typedef struct {
+  int dist;       // OVERFLOW_DIST_*
+  uint64_t seed;
+  double a, b;    // Distribution parameters, see above
+  uint32_t range; // Keys fall in [0, range); 0 = the full 32-bit range
+} overflow_dataset_spec;
+
+typedef struct {
+  uint64_t s[4];
+} overflow_rng;
+
+// Seeds a xoshiro256** state from one 64-bit value via splitmix64.
+void overflow_rng_seed(overflow_rng *rng, uint64_t seed);
+
+static inline uint64_t overflow_rng_next(overflow_rng *rng) {
+  uint64_t *s = rng->s;
+  uint64_t x = s[1] * 5;
+  uint64_t result = (x << 7 | x >> 57) * 9;
+  uint64_t t = s[1] << 17;
+
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= t;
+  s[3] = s[3] << 45 | s[3] >> 19;
+  return result;
+}
+
+// Fills keys[0..n) with up to `threads` workers (0 = all online CPUs). The
+// result depends only on the spec and n.
+void overflow_dataset_generate(uint32_t *keys, size_t n,
+                               const overflow_dataset_spec *spec,
+                               unsigned threads);
+
+// Returns a private read-write mapping of the dataset. With a cache
+// directory (dir, else $OVERFLOW_DATASET_DIR) an existing file is mapped
+// as is; otherwise it is generated into the file first. Without one the
+// dataset is generated into anonymous memory. Writes never reach the file.
+// Returns NULL on failure; release with overflow_dataset_release().
+uint32_t *overflow_dataset_load(const char *dir, size_t n,
+                                const overflow_dataset_spec *spec,
+                                unsigned threads);
+void overflow_dataset_release(uint32_t *keys, size_t n);
+
+#endif
@@ -0,0 +1,188 @@
+/**
+ * @file overflow_encode.c
+ * @brief Sorted uint32_t keys written straight to a delta-encoded stream.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include "overflow_encode.h"
+#include "overflow_engine.h"
+#include "overflow_packed.h"
+#include "overflow_partition.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define BLOCK_HEADER 5    // Minimum delta (4 bytes) and width (1 byte)
+#define ENCODE_SUB_BITS 8 // Log-linear sub-bits of the sort's bins
+#define ENCODE_BINS OVERFLOW_PARTITION_CLASSES(ENCODE_SUB_BITS)
+
+typedef struct {
+  unsigned encoding;
+  uint8_t *out;
+  size_t pos;
+  uint32_t prev;                          // Last key encoded
+  uint32_t deltas[OVERFLOW_ENCODE_BLOCK]; // Pending block
+  size_t fill;
+} Encoder;
+
+static void put_u32le(uint8_t *p, uint32_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+  p[2] = (uint8_t)(v >> 16);
+  p[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t get_u32le(const uint8_t *p) {
+  return p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 |
+         (uint32_t)p[3] << 24;
+}
+
+static void flush_block(Encoder *e) {
+  uint32_t lo = UINT32_MAX, hi = 0;
+  for (size_t i = 0; i < e->fill; ++i) {
+    lo = e->deltas[i] < lo ? e->deltas[i] : lo;
+    hi = e->deltas[i] > hi ? e->deltas[i] : hi;
+  }
+  unsigned width = overflow_tick_u32(hi - lo);
+
+  put_u32le(e->out + e->pos, lo);
+  e->out[e->pos + 4] = (uint8_t)width;
+  e->pos += BLOCK_HEADER;
+  if (width) {
+    uint32_t words[OVERFLOW_ENCODE_BLOCK];
+    size_t bytes = OVERFLOW_PACKED_WORDS(e->fill, width) * sizeof(uint32_t);
+    overflow_pack_u32(e->deltas, e->fill, width, lo, words);
+    memcpy(e->out + e->pos, words, bytes);
+    e->pos += bytes;
+  }
+  e->fill = 0;
+}
+
+static void encode_keys(Encoder *e, const uint32_t *keys, size_t n) {
+  uint32_t prev = e->prev;
+
+  if (e->encoding == OVERFLOW_ENCODE_VARINT) {
+    uint8_t *out = e->out + e->pos;
+    for (size_t i = 0; i < n; ++i) {
+      uint32_t d = keys[i] - prev;
+      prev = keys[i];
+      while (d >= 0x80) {
+        *out++ = (uint8_t)(d | 0x80);
+        d >>= 7;
+      }
+      *out++ = (uint8_t)d;
+    }
+    e->pos = (size_t)(out - e->out);
+  } else {
+    for (size_t i = 0; i < n; ++i) {
+      e->deltas[e->fill++] = keys[i] - prev;
+      prev = keys[i];
+      if (e->fill == OVERFLOW_ENCODE_BLOCK)
+        flush_block(e);
+    }
+  }
+  e->prev = prev;
+}
+
+static void finish(Encoder *e, size_t *written) {
+  if (e->fill)
+    flush_block(e);
+  *written = e->pos;
+}
+
+int overflow_encode_sorted_u32(const uint32_t *sorted, size_t n,
+                               unsigned encoding, uint8_t *out,
+                               size_t *written) {
+  if (encoding > OVERFLOW_ENCODE_BLOCKS)
+    return -1;
+
+  Encoder e = {.encoding = encoding, .out = out};
+  encode_keys(&e, sorted, n);
+  finish(&e, written);
+  return 0;
+}
+
+int overflow_sort_encode_u32(uint32_t *keys, size_t n, unsigned encoding,
+                             uint8_t *out, size_t *written) {
+  if (encoding > OVERFLOW_ENCODE_BLOCKS)
+    return -1;
+  if (n <= OVERFLOW_INSERTION_MAX) {
+    overflow_tick_sort_u32(keys, n, NULL);
+    return overflow_encode_sorted_u32(keys, n, encoding, out, written);
+  }
+
+  // Partition by log-linear bin rather than by tick, so each bin is small
+  // enough to be refined and encoded while it sits in cache
+  uint32_t *scratch = malloc(n * sizeof(uint32_t));
+  size_t *start = malloc((ENCODE_BINS + 1) * sizeof(size_t));
+  if (!scratch || !start ||
+      overflow_partition_log2(keys, n, ENCODE_SUB_BITS, 0, 1, scratch,
+                              start) != 0) {
+    free(scratch);
+    free(start);
+    return -1;
+  }
+
+  // Bins below 2 << sub_bits hold a single key value. Keys of a higher bin
+  // b vary in their low (b >> sub_bits) - 1 bits only, so the bin refines
+  // as if its tick were b >> sub_bits. keys is the refinement temporary.
+  Encoder e = {.encoding = encoding, .out = out};
+  for (unsigned b = 0; b < ENCODE_BINS; ++b) {
+    size_t len = start[b + 1] - start[b];
+    if (len == 0)
+      continue;
+    if (b >= 2u << ENCODE_SUB_BITS)
+      overflow_refine_inplace_u32(&scratch[start[b]], &keys[start[b]], len,
+                                  b >> ENCODE_SUB_BITS, 0);
+    encode_keys(&e, &scratch[start[b]], len);
+  }
+  finish(&e, written);
+  free(scratch);
+  free(start);
+  return 0;
+}
+
+size_t overflow_decode_u32(const uint8_t *in, size_t n, unsigned encoding,
+                           uint32_t *keys) {
+  const uint8_t *p = in;
+  uint32_t prev = 0;
+
+  if (encoding == OVERFLOW_ENCODE_VARINT) {
+    for (size_t i = 0; i < n; ++i) {
+      uint32_t d = 0;
+      unsigned shift = 0;
+      while (*p & 0x80) {
+        d |= (uint32_t)(*p++ & 0x7f) << shift;
+        shift += 7;
+      }
+      d |= (uint32_t)*p++ << shift;
+      keys[i] = prev += d;
+    }
+  } else if (encoding == OVERFLOW_ENCODE_BLOCKS) {
+    uint32_t words[OVERFLOW_ENCODE_BLOCK];
+    for (size_t i = 0; i < n; i += OVERFLOW_ENCODE_BLOCK) {
+      size_t len = n - i < OVERFLOW_ENCODE_BLOCK ? n - i
+                                                  : OVERFLOW_ENCODE_BLOCK;
+      uint32_t lo = get_u32le(p);
+      unsigned width = p[4];
+      p += BLOCK_HEADER;
+
+      if (width) {
+        size_t bytes = OVERFLOW_PACKED_WORDS(len, width) * sizeof(uint32_t);
+        overflow_packed_u32 block = {words, len, width, lo};
+        memcpy(words, p, bytes);
+        p += bytes;
+        overflow_unpack_u32(&block, 0, len, &keys[i]);
+      } else {
+        for (size_t j = 0; j < len; ++j)
+          keys[i + j] = lo;
+      }
+      for (size_t j = 0; j < len; ++j)
+        keys[i + j] = prev += keys[i + j];
+    }
+  }
+  return (size_t)(p - in);
+}
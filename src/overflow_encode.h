@@ -0,0 +1,61 @@
+/**
+ * @file overflow_encode.h
+ * @brief Sorted uint32_t keys written straight to a delta-encoded stream.
+ *
+ * Sorted key lists are usually compressed before they are stored or
+ * sent, and a sorted array is written only to be read back by the
+ * compressor. overflow_sort_encode_u32() scatters keys into log-linear
+ * bins and encodes each bin right after refining it, while it is still in
+ * cache, so the sorted array is never written out. Keys
+ * are stored as deltas from the previous key, in one of two formats:
+ *
+ * - OVERFLOW_ENCODE_VARINT: one LEB128 varint per delta, 7 bits per byte.
+ * - OVERFLOW_ENCODE_BLOCKS: blocks of OVERFLOW_ENCODE_BLOCK deltas, each a
+ *   4-byte little-endian minimum delta and a width byte, followed by the
+ *   deltas minus that minimum bit-packed as in overflow_packed.h. Width 0
+ *   means every delta of the block equals the minimum.
+ *
+ * The key count is not stored; the decoder is given it. For (value, run
+ * length) output, overflow_count_distinct_sorted() in overflow_unique.h
+ * already writes the runs without sorting the full array.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#ifndef OVERFLOW_ENCODE_H
+#define OVERFLOW_ENCODE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Encodings
+#define OVERFLOW_ENCODE_VARINT 0 // LEB128 deltas
+#define OVERFLOW_ENCODE_BLOCKS 1 // Bit-packed deltas per block
+
+#define OVERFLOW_ENCODE_BLOCK 128 // Deltas per bit-packed block
+
+// Output bound for n keys in either encoding.
+#define OVERFLOW_ENCODE_MAX_BYTES(n)                                          \
+  ((size_t)(n) * 5 + ((size_t)(n) / OVERFLOW_ENCODE_BLOCK + 1) * 5)
+
+// Encodes sorted[0..n), which must be ascending, to out, which needs
+// OVERFLOW_ENCODE_MAX_BYTES(n) bytes, and stores the bytes used in
+// *written. Returns 0, or -1 for an unknown encoding.
+int overflow_encode_sorted_u32(const uint32_t *sorted, size_t n,
+                               unsigned encoding, uint8_t *out,
+                               size_t *written);
+
+// Sorts keys[0..n) and encodes them as above. keys is left in an
+// unspecified order. Returns 0, or -1 for an unknown encoding or if
+// scratch allocation fails.
+int overflow_sort_encode_u32(uint32_t *keys, size_t n, unsigned encoding,
+                             uint8_t *out, size_t *written);
+
+// Decodes n keys from in into keys and returns the bytes read. The input
+// is trusted to be a stream produced by the encoders above.
+size_t overflow_decode_u32(const uint8_t *in, size_t n, unsigned encoding,
+                           uint32_t *keys);
+
+#endif
@@ -0,0 +1,222 @@
+/**
+ * @file overflow_engine.c
+ * @brief Reusable tick-bucket sort for uint32_t keys.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include "overflow_engine.h"
+#include "overflow_hugepage.h"
+#include "overflow_tick.h"
+#include "overflow_vec.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define RADIX_BITS 8
+#define RADIX_BINS (1u << RADIX_BITS)
+
+static inline void cmp_swap(uint32_t *a, uint32_t *b) {
+  uint32_t lo = *a < *b ? *a : *b;
+  uint32_t hi = *a < *b ? *b : *a;
+  *a = lo;
+  *b = hi;
+}
+
+// Batcher odd-even merge network over a fixed power-of-two width; the loop
+// bounds are constants so the compiler unrolls it into straight-line min/max.
+static inline void network_pow2(uint32_t *v, size_t width) {
+  for (size_t p = 1; p < width; p <<= 1)
+    for (size_t k = p; k >= 1; k >>= 1)
+      for (size_t j = k % p; j + k < width; j += 2 * k)
+        for (size_t i = 0; i < k && i + j + k < width; ++i)
+          if ((i + j) / (2 * p) == (i + j + k) / (2 * p))
+            cmp_swap(&v[i + j], &v[i + j + k]);
+}
+
+void overflow_network_sort_u32(uint32_t *keys, size_t n) {
+  uint32_t pad[OVERFLOW_NETWORK_MAX];
+  size_t width = n <= 4 ? 4 : n <= 8 ? 8 : OVERFLOW_NETWORK_MAX;
+
+  if (n < 2)
+    return;
+  memcpy(pad, keys, n * sizeof(uint32_t));
+  for (size_t i = n; i < width; ++i)
+    pad[i] = UINT32_MAX;
+
+  if (width == 4)
+    network_pow2(pad, 4);
+  else if (width == 8)
+    network_pow2(pad, 8);
+  else
+    network_pow2(pad, OVERFLOW_NETWORK_MAX);
+
+  memcpy(keys, pad, n * sizeof(uint32_t));
+}
+
+static void insertion_sort_u32(uint32_t *keys, size_t n) {
+  for (size_t i = 1; i < n; ++i) {
+    uint32_t key = keys[i];
+    size_t j = i;
+    while (j > 0 && keys[j - 1] > key) {
+      keys[j] = keys[j - 1];
+      --j;
+    }
+    keys[j] = key;
+  }
+}
+
+void overflow_tick_histogram_u32(const uint32_t *keys, size_t n,
+                                 size_t *counts) {
+  overflow_vec_best()->histogram_u32(keys, n, counts);
+}
+
+void overflow_add_u32(uint32_t *keys, size_t n, uint32_t delta) {
+  for (size_t i = 0; i < n; ++i)
+    keys[i] += delta;
+}
+
+static void copy_out(uint32_t *dst, const uint32_t *src, size_t n,
+                     unsigned flags) {
+  if (flags & OVERFLOW_STREAM_OUTPUT)
+    overflow_stream_copy_u32(dst, src, n);
+  else
+    memcpy(dst, src, n * sizeof(uint32_t));
+}
+
+// LSD radix over the low `bits` bits, ping-ponging a <-> b. Returns the
+// buffer holding the result.
+static uint32_t *radix_passes(uint32_t *a, uint32_t *b, size_t n,
+                              unsigned bits) {
+  uint32_t *from = a;
+  uint32_t *to = b;
+
+  for (unsigned shift = 0; shift < bits; shift += RADIX_BITS) {
+    size_t count[RADIX_BINS] = {0};
+    for (size_t i = 0; i < n; ++i)
+      count[(from[i] >> shift) & (RADIX_BINS - 1)]++;
+
+    // Skip digits every key agrees on
+    if (count[(from[0] >> shift) & (RADIX_BINS - 1)] == n)
+      continue;
+
+    size_t sum = 0;
+    for (unsigned d = 0; d < RADIX_BINS; ++d) {
+      size_t c = count[d];
+      count[d] = sum;
+      sum += c;
+    }
+    for (size_t i = 0; i < n; ++i)
+      to[count[(from[i] >> shift) & (RADIX_BINS - 1)]++] = from[i];
+
+    uint32_t *t = from;
+    from = to;
+    to = t;
+  }
+  return from;
+}
+
+void overflow_refine_bucket_u32(uint32_t *src, uint32_t *dst, size_t n,
+                                unsigned tick, unsigned flags) {
+  // Everything below the leading bit still needs ordering
+  unsigned bits = tick > 1 ? tick - 1 : 0;
+
+  if (n < 2 || bits == 0) {
+    copy_out(dst, src, n, flags);
+    return;
+  }
+  if (n <= OVERFLOW_INSERTION_MAX) {
+    memcpy(dst, src, n * sizeof(uint32_t));
+    insertion_sort_u32(dst, n);
+    return;
+  }
+
+  uint32_t *result = radix_passes(src, dst, n, bits);
+  if (result != dst)
+    copy_out(dst, result, n, flags);
+}
+
+void overflow_refine_inplace_u32(uint32_t *keys, uint32_t *tmp, size_t n,
+                                 unsigned tick, unsigned flags) {
+  unsigned bits = tick > 1 ? tick - 1 : 0;
+
+  if (n < 2 || bits == 0)
+    return;
+  if (n <= OVERFLOW_INSERTION_MAX) {
+    insertion_sort_u32(keys, n);
+    return;
+  }
+
+  uint32_t *result = radix_passes(keys, tmp, n, bits);
+  if (result != keys)
+    copy_out(keys, result, n, flags);
+}
+
+void overflow_tick_sort_flags_u32(uint32_t *keys, size_t n, uint32_t *scratch,
+                                  unsigned flags) {
+  size_t counts[OVERFLOW_TICKS_U32];
+  size_t offsets[OVERFLOW_TICKS_U32];
+
+  if (n <= OVERFLOW_NETWORK_MAX) {
+    overflow_network_sort_u32(keys, n);
+    return;
+  }
+  if (n <= OVERFLOW_INSERTION_MAX) {
+    insertion_sort_u32(keys, n);
+    return;
+  }
+
+  uint32_t lo, hi, base = 0;
+  overflow_vec_best()->histogram_minmax_u32(keys, n, counts, &lo, &hi);
+  if (lo == hi)
+    return; // All keys equal
+
+  // Range rebase: tick key - lo when that splits the keys finer
+  if (overflow_tick_u32(hi - lo) < overflow_tick_u32(hi)) {
+    base = lo;
+    overflow_add_u32(keys, n, -base);
+    overflow_tick_histogram_u32(keys, n, counts);
+  }
+
+  size_t sum = 0;
+  for (int t = 0; t < OVERFLOW_TICKS_U32; ++t) {
+    offsets[t] = sum;
+    sum += counts[t];
+  }
+
+  // Stable scatter by tick
+  size_t cursor[OVERFLOW_TICKS_U32];
+  memcpy(cursor, offsets, sizeof(cursor));
+  for (size_t i = 0; i < n; ++i)
+    scratch[cursor[overflow_tick_u32(keys[i])]++] = keys[i];
+
+  // Refine each bucket back into keys
+  for (int t = 0; t < OVERFLOW_TICKS_U32; ++t) {
+    if (counts[t] == 0)
+      continue;
+    overflow_refine_bucket_u32(&scratch[offsets[t]], &keys[offsets[t]],
+                               counts[t], (unsigned)t, flags);
+    if (base)
+      overflow_add_u32(&keys[offsets[t]], counts[t], base);
+  }
+}
+
+void overflow_tick_sort_u32(uint32_t *keys, size_t n, uint32_t *scratch) {
+  overflow_tick_sort_flags_u32(keys, n, scratch, 0);
+}
+
+int overflow_sort_u32(uint32_t *keys, size_t n) {
+  if (n <= OVERFLOW_INSERTION_MAX) {
+    overflow_tick_sort_u32(keys, n, NULL);
+    return 0;
+  }
+
+  uint32_t *scratch = malloc(n * sizeof(uint32_t));
+  if (!scratch)
+    return -1;
+  overflow_tick_sort_u32(keys, n, scratch);
+  free(scratch);
+  return 0;
+}
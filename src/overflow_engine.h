@@ -0,0 +1,58 @@
+/**
+ * @file overflow_engine.h
+ * @brief Reusable tick-bucket sort for uint32_t keys.
+ *
+ * Keys are first scattered by overflow tick (see overflow_tick.h) and each
+ * bucket is then refined on the bits below its leading bit. The tick
+ * histogram pass also finds the smallest and largest key: keys packed in a
+ * narrow band far from zero (timestamps, dense IDs) all share one tick, so
+ * when max - min has fewer significant bits than max they are sorted as
+ * key - min instead and shifted back bucket by bucket. All entry points
+ * sort in place; the `_scratch` variants never allocate.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#ifndef OVERFLOW_ENGINE_H
+#define OVERFLOW_ENGINE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define OVERFLOW_NETWORK_MAX 16   // Largest input handled by the network
+#define OVERFLOW_INSERTION_MAX 48 // Buckets below this skip radix refinement
+
+// Engine flags
+#define OVERFLOW_STREAM_OUTPUT 0x1 // Non-temporal stores for final copies
+
+// Branch-free sorting network for n <= OVERFLOW_NETWORK_MAX keys.
+void overflow_network_sort_u32(uint32_t *keys, size_t n);
+
+// Stable tick sort; scratch must hold n keys.
+void overflow_tick_sort_u32(uint32_t *keys, size_t n, uint32_t *scratch);
+void overflow_tick_sort_flags_u32(uint32_t *keys, size_t n, uint32_t *scratch,
+                                  unsigned flags);
+
+// keys[i] += delta for every key, wrapping; a negated delta undoes it.
+void overflow_add_u32(uint32_t *keys, size_t n, uint32_t delta);
+
+// Tick histogram of keys[0..n) into counts[OVERFLOW_TICKS_U32].
+void overflow_tick_histogram_u32(const uint32_t *keys, size_t n,
+                                 size_t *counts);
+
+// Sorts one tick bucket of n keys sharing leading bit `tick`. Keys start in
+// src; the result is written to dst, using src as the ping-pong buffer.
+void overflow_refine_bucket_u32(uint32_t *src, uint32_t *dst, size_t n,
+                                unsigned tick, unsigned flags);
+
+// Same refinement for a bucket that is already in place; tmp must hold n
+// keys.
+void overflow_refine_inplace_u32(uint32_t *keys, uint32_t *tmp, size_t n,
+                                 unsigned tick, unsigned flags);
+
+// Allocating wrapper; returns 0 on success, -1 if scratch allocation fails.
+int overflow_sort_u32(uint32_t *keys, size_t n);
+
+#endif
@@ -0,0 +1,62 @@
+/**
+ * @file overflow_heap.c
+ * @brief Radix heaps for uint32_t and uint64_t keys.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include "overflow_heap.h"
+#include "overflow_tick.h"
+#include "overflow_vec.h"
+
+#include <stdlib.h>
+
+#define HEAP_BLOCK 1024 // Keys per tick block while redistributing
+#define HEAP_MIN_CAP 16 // First allocation of a bucket, in entries
+
+// There are no 64-bit kernels; these are the scalar loops.
+static void ticks_u64(const uint64_t *keys, size_t n, uint8_t *ticks) {
+  for (size_t i = 0; i < n; ++i)
+    ticks[i] = (uint8_t)overflow_tick_u64(keys[i]);
+}
+
+static uint64_t min_u64(const uint64_t *keys, size_t n) {
+  uint64_t m = UINT64_MAX;
+  for (size_t i = 0; i < n; ++i)
+    m = keys[i] < m ? keys[i] : m;
+  return m;
+}
+
+#define HEAP_T overflow_radix_heap_u32
+#define KEY_T uint32_t
+#define HEAP_FN(name) overflow_radix_heap_##name##_u32
+#define HEAP_TICKS OVERFLOW_TICKS_U32
+#define HEAP_TICK(v) overflow_tick_u32(v)
+#define HEAP_MIN(h, keys, n) (h)->ops->min_u32(keys, n)
+#define HEAP_TICK_BLOCK(h, diff, n, ticks) (h)->ops->ticks_u32(diff, n, ticks)
+#include "overflow_heap_impl.inc"
+#undef HEAP_T
+#undef KEY_T
+#undef HEAP_FN
+#undef HEAP_TICKS
+#undef HEAP_TICK
+#undef HEAP_MIN
+#undef HEAP_TICK_BLOCK
+
+#define HEAP_T overflow_radix_heap_u64
+#define KEY_T uint64_t
+#define HEAP_FN(name) overflow_radix_heap_##name##_u64
+#define HEAP_TICKS OVERFLOW_TICKS_U64
+#define HEAP_TICK(v) overflow_tick_u64(v)
+#define HEAP_MIN(h, keys, n) min_u64(keys, n)
+#define HEAP_TICK_BLOCK(h, diff, n, ticks) ticks_u64(diff, n, ticks)
+#include "overflow_heap_impl.inc"
+#undef HEAP_T
+#undef KEY_T
+#undef HEAP_FN
+#undef HEAP_TICKS
+#undef HEAP_TICK
+#undef HEAP_MIN
+#undef HEAP_TICK_BLOCK
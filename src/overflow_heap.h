@@ -0,0 +1,59 @@
+/**
+ * @file overflow_heap.h
+ * @brief Monotone priority queues (radix heaps) over tick buckets.
+ *
+ * A radix heap only accepts keys no smaller than the last key popped,
+ * which is what Dijkstra, event simulation and other label-setting loops
+ * produce. A key is filed under the tick of `key ^ last`, the position of
+ * the highest bit where it differs from the last popped key, so a push is
+ * one bit scan and an append. A pop takes bucket 0, whose keys all equal
+ * `last`; when it is empty the lowest nonempty bucket is found in a mask,
+ * its minimum becomes the new `last`, and its entries are redistributed
+ * into strictly lower buckets with the vectorized tick kernels. Every entry
+ * moves down at most once per bucket, which makes push and pop O(1)
+ * amortized for a fixed key width.
+ *
+ * Each key carries a uint32_t payload, typically a vertex or event index.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#ifndef OVERFLOW_HEAP_H
+#define OVERFLOW_HEAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct overflow_radix_heap_u32 overflow_radix_heap_u32;
+typedef struct overflow_radix_heap_u64 overflow_radix_heap_u64;
+
+// Returns an empty heap, or NULL if allocation fails.
+overflow_radix_heap_u32 *overflow_radix_heap_create_u32(void);
+void overflow_radix_heap_destroy_u32(overflow_radix_heap_u32 *h);
+
+// Adds key with its payload. Returns 0, or -1 if key is below the last key
+// popped or allocation fails.
+int overflow_radix_heap_push_u32(overflow_radix_heap_u32 *h, uint32_t key,
+                                 uint32_t payload);
+
+// Removes a smallest key, storing it and its payload (either may be NULL).
+// Equal keys come out in no particular order. Returns 0, or -1 if the heap
+// is empty or redistributing a bucket can't allocate; the heap is left
+// unchanged then.
+int overflow_radix_heap_pop_u32(overflow_radix_heap_u32 *h, uint32_t *key,
+                                uint32_t *payload);
+
+size_t overflow_radix_heap_size_u32(const overflow_radix_heap_u32 *h);
+
+// The same for uint64_t keys; the payload stays uint32_t.
+overflow_radix_heap_u64 *overflow_radix_heap_create_u64(void);
+void overflow_radix_heap_destroy_u64(overflow_radix_heap_u64 *h);
+int overflow_radix_heap_push_u64(overflow_radix_heap_u64 *h, uint64_t key,
+                                 uint32_t payload);
+int overflow_radix_heap_pop_u64(overflow_radix_heap_u64 *h, uint64_t *key,
+                                uint32_t *payload);
+size_t overflow_radix_heap_size_u64(const overflow_radix_heap_u64 *h);
+
+#endif
@@ -0,0 +1,137 @@
+/**
+ * @file overflow_hugepage.c
+ * @brief Large-page scratch allocation and streaming output copies.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#define _GNU_SOURCE
+#include "overflow_hugepage.h"
+#include "overflow_parallel.h"
+
+#include <pthread.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#define SMALL_PAGE 4096
+
+typedef struct {
+  char *base;
+  size_t lo;
+  size_t hi;
+} PrefaultSlice;
+
+// Writes one byte per small page so the fault happens here, not mid-sort;
+// with THP each first touch of a 2 MiB region maps the whole huge page.
+static void *prefault_slice(void *arg) {
+  PrefaultSlice *s = arg;
+  for (size_t off = s->lo; off < s->hi; off += SMALL_PAGE)
+    s->base[off] = 0;
+  return NULL;
+}
+
+static void prefault(char *base, size_t bytes, unsigned threads) {
+  pthread_t tids[OVERFLOW_MAX_THREADS];
+  PrefaultSlice slices[OVERFLOW_MAX_THREADS];
+  size_t pages = bytes / OVERFLOW_HUGE_PAGE;
+
+  if (threads == 0)
+    threads = overflow_parallel_threads();
+  if (threads > pages)
+    threads = pages ? (unsigned)pages : 1;
+
+  // Split on huge-page boundaries so no page is faulted by two threads
+  size_t per = pages / threads;
+  unsigned started = 1;
+  for (unsigned i = 0; i < threads; ++i) {
+    slices[i].base = base;
+    slices[i].lo = per * i * OVERFLOW_HUGE_PAGE;
+    slices[i].hi =
+        i + 1 == threads ? bytes : per * (i + 1) * OVERFLOW_HUGE_PAGE;
+  }
+  for (; started < threads; ++started)
+    if (pthread_create(&tids[started], NULL, prefault_slice,
+                       &slices[started]) != 0)
+      break;
+
+  // Whatever didn't get a thread is faulted here
+  prefault_slice(&slices[0]);
+  for (unsigned i = started; i < threads; ++i)
+    prefault_slice(&slices[i]);
+  for (unsigned i = 1; i < started; ++i)
+    pthread_join(tids[i], NULL);
+}
+
+void *overflow_huge_alloc(size_t bytes, int mode, unsigned threads,
+                          size_t *mapped) {
+  size_t len =
+      (bytes + OVERFLOW_HUGE_PAGE - 1) & ~(size_t)(OVERFLOW_HUGE_PAGE - 1);
+  void *ptr = MAP_FAILED;
+
+  if (len == 0)
+    len = OVERFLOW_HUGE_PAGE;
+
+#ifdef MAP_HUGETLB
+  if (mode == OVERFLOW_PAGES_HUGETLB)
+    ptr = mmap(NULL, len, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#endif
+
+  if (ptr == MAP_FAILED) {
+    // Over-map by one huge page so the start can be 2 MiB aligned, which
+    // THP needs to back the range with huge pages from the first byte
+    size_t raw_len = len + OVERFLOW_HUGE_PAGE;
+    char *raw = mmap(NULL, raw_len, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED)
+      return NULL;
+
+    uintptr_t start = ((uintptr_t)raw + OVERFLOW_HUGE_PAGE - 1) &
+                      ~(uintptr_t)(OVERFLOW_HUGE_PAGE - 1);
+    size_t head = start - (uintptr_t)raw;
+    if (head)
+      munmap(raw, head);
+    if (raw_len - head > len)
+      munmap((char *)start + len, raw_len - head - len);
+    ptr = (void *)start;
+
+#ifdef MADV_HUGEPAGE
+    if (mode != OVERFLOW_PAGES_SMALL)
+      madvise(ptr, len, MADV_HUGEPAGE);
+#endif
+  }
+
+  prefault(ptr, len, threads);
+  *mapped = len;
+  return ptr;
+}
+
+void overflow_huge_free(void *ptr, size_t mapped) {
+  if (ptr)
+    munmap(ptr, mapped);
+}
+
+void overflow_stream_copy_u32(uint32_t *dst, const uint32_t *src, size_t n) {
+#ifdef __SSE2__
+  size_t i = 0;
+
+  // Scalar head until dst is 16-byte aligned
+  for (; i < n && ((uintptr_t)&dst[i] & 15); ++i)
+    dst[i] = src[i];
+  for (; i + 4 <= n; i += 4)
+    _mm_stream_si128((__m128i *)&dst[i],
+                     _mm_loadu_si128((const __m128i *)&src[i]));
+  for (; i < n; ++i)
+    dst[i] = src[i];
+  _mm_sfence();
+#else
+  memcpy(dst, src, n * sizeof(uint32_t));
+#endif
+}
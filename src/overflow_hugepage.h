@@ -0,0 +1,42 @@
+/**
+ * @file overflow_hugepage.h
+ * @brief Large-page scratch allocation and streaming output copies.
+ *
+ * The random scatter of a 100M+ key sort touches far more 4 KiB pages than
+ * the TLB can map. Scratch from overflow_huge_alloc() sits on 2 MiB pages
+ * (transparent huge pages via madvise, or explicit MAP_HUGETLB pages when
+ * requested and reserved) and is prefaulted by several threads up front so
+ * the sort itself never takes a page fault.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#ifndef OVERFLOW_HUGEPAGE_H
+#define OVERFLOW_HUGEPAGE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define OVERFLOW_HUGE_PAGE (2u << 20)
+
+// Page modes for scratch arenas
+enum {
+  OVERFLOW_PAGES_SMALL = 0,  // Plain aligned heap allocation
+  OVERFLOW_PAGES_HUGE = 1,   // mmap + madvise(MADV_HUGEPAGE)
+  OVERFLOW_PAGES_HUGETLB = 2 // MAP_HUGETLB, falling back to HUGE
+};
+
+// Maps at least `bytes` rounded up to whole huge pages and prefaults them
+// with `threads` workers (0 = all online CPUs). *mapped receives the length
+// to pass to overflow_huge_free(). Returns NULL on failure.
+void *overflow_huge_alloc(size_t bytes, int mode, unsigned threads,
+                          size_t *mapped);
+void overflow_huge_free(void *ptr, size_t mapped);
+
+// Copies n keys with non-temporal stores, bypassing the cache for output
+// that won't be reread soon. Falls back to memcpy without SSE2.
+void overflow_stream_copy_u32(uint32_t *dst, const uint32_t *src, size_t n);
+
+#endif
@@ -0,0 +1,103 @@
+/**
+ * @file overflow_iter.c
+ * @brief Lazy sorted iteration over uint32_t keys.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include "overflow_iter.h"
+#include "overflow_engine.h"
+#include "overflow_partition.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define SUB OVERFLOW_ITER_SUB_BITS
+#define NBINS OVERFLOW_PARTITION_CLASSES(SUB)
+
+struct overflow_sorted_iter {
+  uint32_t *keys;          // Scattered by bin; bins before next_bin sorted
+  uint32_t *tmp;           // Refinement scratch, as large as the largest bin
+  size_t start[NBINS + 1]; // Bin offsets in keys
+  size_t n;
+  size_t pos;        // Next key to return
+  unsigned next_bin; // First bin not yet refined or skipped
+};
+
+overflow_sorted_iter *overflow_sorted_iter_create(const uint32_t *keys,
+                                                  size_t n) {
+  overflow_sorted_iter *it = calloc(1, sizeof(*it));
+  if (!it)
+    return NULL;
+
+  it->n = n;
+  it->keys = malloc((n ? n : 1) * sizeof(uint32_t));
+  if (!it->keys ||
+      overflow_partition_log2(keys, n, SUB, 0, 1, it->keys, it->start) != 0) {
+    overflow_sorted_iter_destroy(it);
+    return NULL;
+  }
+
+  size_t largest = 0;
+  for (unsigned b = 0; b < NBINS; ++b) {
+    size_t len = it->start[b + 1] - it->start[b];
+    largest = len > largest ? len : largest;
+  }
+  it->tmp = malloc((largest ? largest : 1) * sizeof(uint32_t));
+  if (!it->tmp) {
+    overflow_sorted_iter_destroy(it);
+    return NULL;
+  }
+  return it;
+}
+
+void overflow_sorted_iter_destroy(overflow_sorted_iter *it) {
+  if (!it)
+    return;
+  free(it->keys);
+  free(it->tmp);
+  free(it);
+}
+
+// Sorts the next bin in place. Bins below 2 << SUB hold one key value each
+// and are already in order. Above that, keys of bin b agree on everything
+// but their low (b >> SUB) - 1 bits, so the bin is refined as if its tick
+// were b >> SUB and the radix passes only cover those bits.
+static void refine_next(overflow_sorted_iter *it) {
+  unsigned b = it->next_bin++;
+  size_t len = it->start[b + 1] - it->start[b];
+  if (b >= 2u << SUB && len > 1)
+    overflow_refine_inplace_u32(&it->keys[it->start[b]], it->tmp, len,
+                                b >> SUB, 0);
+}
+
+size_t overflow_sorted_iter_next(overflow_sorted_iter *it, uint32_t *out,
+                                 size_t max) {
+  size_t copied = 0;
+  while (copied < max && it->pos < it->n) {
+    while (it->start[it->next_bin] <= it->pos)
+      refine_next(it);
+    size_t ready = it->start[it->next_bin] - it->pos;
+    size_t len = max - copied < ready ? max - copied : ready;
+    memcpy(&out[copied], &it->keys[it->pos], len * sizeof(uint32_t));
+    copied += len;
+    it->pos += len;
+  }
+  return copied;
+}
+
+size_t overflow_sorted_iter_skip(overflow_sorted_iter *it, size_t count) {
+  size_t left = it->n - it->pos;
+  size_t skipped = count < left ? count : left;
+
+  it->pos += skipped;
+  while (it->next_bin < NBINS && it->start[it->next_bin + 1] <= it->pos)
+    it->next_bin++;
+  return skipped;
+}
+
+size_t overflow_sorted_iter_remaining(const overflow_sorted_iter *it) {
+  return it->n - it->pos;
+}
@@ -0,0 +1,46 @@
+/**
+ * @file overflow_iter.h
+ * @brief Lazy sorted iteration over uint32_t keys.
+ *
+ * Creating an iterator copies the keys into log-linear bins (the tick
+ * bucket split by the OVERFLOW_ITER_SUB_BITS bits below the leading bit,
+ * see overflow_tick.h) with one vectorized histogram pass and one scatter.
+ * No bin is sorted yet. Each bin is refined the first time the iterator
+ * reaches it, so reading the first k keys costs the up-front pass plus the
+ * bins those k keys live in. overflow_sorted_iter_skip() steps over whole
+ * bins without sorting them, which makes paging cheap too.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#ifndef OVERFLOW_ITER_H
+#define OVERFLOW_ITER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define OVERFLOW_ITER_SUB_BITS 8 // Sub-bins per tick bucket: 2^8
+
+typedef struct overflow_sorted_iter overflow_sorted_iter;
+
+// Starts an ascending iteration over keys[0..n); the keys are copied and
+// not modified. Returns NULL if allocation fails.
+overflow_sorted_iter *overflow_sorted_iter_create(const uint32_t *keys,
+                                                  size_t n);
+void overflow_sorted_iter_destroy(overflow_sorted_iter *it);
+
+// Copies the next keys, up to max, into out. Returns how many were copied;
+// 0 once every key has been returned.
+size_t overflow_sorted_iter_next(overflow_sorted_iter *it, uint32_t *out,
+                                 size_t max);
+
+// Steps over the next count keys (fewer at the end) without sorting the
+// bins that fall entirely inside them. Returns how many were skipped.
+size_t overflow_sorted_iter_skip(overflow_sorted_iter *it, size_t count);
+
+// Keys not yet returned or skipped.
+size_t overflow_sorted_iter_remaining(const overflow_sorted_iter *it);
+
+#endif
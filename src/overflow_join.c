@@ -0,0 +1,269 @@
+/**
+ * @file overflow_join.c
+ * @brief Partitioned sort-merge equi-join of two uint32_t key columns.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include "overflow_join.h"
+#include "overflow_parallel.h"
+#include "overflow_tick.h"
+#include "overflow_vec.h"
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define JOIN_BLOCK 1024 // Keys per block of bin indices
+#define JOIN_SMALL 32   // Partitions up to this size use insertion sort
+#define JOIN_DIGIT 8    // Radix digit width inside a partition
+
+typedef struct {
+  uint32_t key; // Rebased key
+  uint32_t idx; // Row in the input column
+} JoinRow;
+
+typedef struct {
+  JoinRow *rows[2], *tmp[2]; // Left and right, partitioned by bin
+  size_t *start[2];          // Bin b is rows[side][start[b], start[b + 1])
+  size_t *offset;            // Output pairs of bin b, then their offsets
+  overflow_join_pair *out;   // NULL while counting
+  unsigned mode, sub_bits, nbins;
+  atomic_uint next;
+} JoinJob;
+
+// Scatters keys[0..n), rebased on base, into rows by log-linear bin, in
+// input order within each bin. start needs nbins + 1 entries.
+static int partition_column(const uint32_t *keys, size_t n, uint32_t base,
+                            unsigned s, size_t *start, JoinRow *rows) {
+  const overflow_vec_ops *ops = overflow_vec_best();
+  unsigned nbins = OVERFLOW_LOGLIN_BINS_U32(s);
+  size_t *cursor = calloc(nbins, sizeof(size_t));
+  uint32_t diff[JOIN_BLOCK];
+  uint16_t bins[JOIN_BLOCK];
+
+  if (!cursor)
+    return -1;
+  for (size_t i = 0; i < n; i += JOIN_BLOCK) {
+    size_t len = n - i < JOIN_BLOCK ? n - i : JOIN_BLOCK;
+    for (size_t j = 0; j < len; ++j)
+      diff[j] = keys[i + j] - base;
+    ops->loglin_u32(diff, len, s, bins);
+    for (size_t j = 0; j < len; ++j)
+      cursor[bins[j]]++;
+  }
+
+  size_t sum = 0;
+  for (unsigned b = 0; b < nbins; ++b) {
+    start[b] = sum;
+    sum += cursor[b];
+    cursor[b] = start[b];
+  }
+  start[nbins] = n;
+
+  for (size_t i = 0; i < n; i += JOIN_BLOCK) {
+    size_t len = n - i < JOIN_BLOCK ? n - i : JOIN_BLOCK;
+    for (size_t j = 0; j < len; ++j)
+      diff[j] = keys[i + j] - base;
+    ops->loglin_u32(diff, len, s, bins);
+    for (size_t j = 0; j < len; ++j)
+      rows[cursor[bins[j]]++] = (JoinRow){diff[j], (uint32_t)(i + j)};
+  }
+  free(cursor);
+  return 0;
+}
+
+// Stable sort of one partition by key. Only the low `bits` bits vary.
+static void sort_rows(JoinRow *rows, JoinRow *tmp, size_t n, unsigned bits) {
+  if (n <= JOIN_SMALL) {
+    for (size_t i = 1; i < n; ++i) {
+      JoinRow r = rows[i];
+      size_t j = i;
+      for (; j > 0 && rows[j - 1].key > r.key; --j)
+        rows[j] = rows[j - 1];
+      rows[j] = r;
+    }
+    return;
+  }
+
+  enum { RADIX = 1 << JOIN_DIGIT, MAX_DIGITS = 32 / JOIN_DIGIT };
+  unsigned digits = (bits + JOIN_DIGIT - 1) / JOIN_DIGIT;
+  size_t counts[MAX_DIGITS][RADIX];
+  memset(counts, 0, sizeof(counts));
+  for (size_t i = 0; i < n; ++i)
+    for (unsigned d = 0; d < digits; ++d)
+      counts[d][rows[i].key >> (d * JOIN_DIGIT) & (RADIX - 1)]++;
+
+  JoinRow *src = rows, *dst = tmp;
+  for (unsigned d = 0; d < digits; ++d) {
+    unsigned shift = d * JOIN_DIGIT;
+    if (counts[d][src[0].key >> shift & (RADIX - 1)] == n)
+      continue; // Every key shares this digit
+
+    size_t sum = 0;
+    for (unsigned v = 0; v < RADIX; ++v) {
+      size_t c = counts[d][v];
+      counts[d][v] = sum;
+      sum += c;
+    }
+    for (size_t i = 0; i < n; ++i)
+      dst[counts[d][src[i].key >> shift & (RADIX - 1)]++] = src[i];
+    JoinRow *t = src;
+    src = dst;
+    dst = t;
+  }
+  if (src != rows)
+    memcpy(rows, src, n * sizeof(JoinRow));
+}
+
+// Merges two key-sorted partitions, writing the pairs to out unless it is
+// NULL. Returns the number of pairs.
+static size_t merge_rows(const JoinRow *l, size_t nl, const JoinRow *r,
+                         size_t nr, unsigned mode, overflow_join_pair *out) {
+  size_t i = 0, j = 0, count = 0;
+
+  while (i < nl && j < nr) {
+    if (l[i].key < r[j].key) {
+      i++;
+    } else if (l[i].key > r[j].key) {
+      j++;
+    } else {
+      uint32_t key = l[i].key;
+      size_t i_end = i, j_end = j;
+      while (i_end < nl && l[i_end].key == key)
+        i_end++;
+      while (j_end < nr && r[j_end].key == key)
+        j_end++;
+
+      if (mode == OVERFLOW_JOIN_SEMI) {
+        if (out)
+          for (size_t a = i; a < i_end; ++a)
+            out[count + a - i] = (overflow_join_pair){l[a].idx, r[j].idx};
+        count += i_end - i;
+      } else {
+        if (out)
+          for (size_t a = i; a < i_end; ++a)
+            for (size_t b = j; b < j_end; ++b)
+              out[count++] = (overflow_join_pair){l[a].idx, r[b].idx};
+        else
+          count += (i_end - i) * (j_end - j);
+      }
+      i = i_end;
+      j = j_end;
+    }
+  }
+  return count;
+}
+
+// Claims partitions, widest bins first. While counting, each claimed pair
+// is sorted and its output counted; afterwards the same pairs are merged
+// into their output slots.
+static void join_worker(void *arg, unsigned id) {
+  JoinJob *job = arg;
+  unsigned s = job->sub_bits;
+  (void)id;
+
+  for (;;) {
+    unsigned i = atomic_fetch_add(&job->next, 1);
+    if (i >= job->nbins)
+      return;
+    unsigned b = job->nbins - 1 - i;
+    size_t lo[2], n[2];
+    for (int side = 0; side < 2; ++side) {
+      lo[side] = job->start[side][b];
+      n[side] = job->start[side][b + 1] - lo[side];
+    }
+    JoinRow *l = job->rows[0] + lo[0], *r = job->rows[1] + lo[1];
+
+    if (job->out) {
+      if (job->offset[b + 1] != job->offset[b])
+        merge_rows(l, n[0], r, n[1], job->mode, job->out + job->offset[b]);
+      continue;
+    }
+    job->offset[b] = 0;
+    if (!n[0] || !n[1])
+      continue;
+    if (b >= 2u << s) {
+      // Bins below 2 << s hold a single key each and need no sort
+      unsigned bits = (b >> s) - 1;
+      sort_rows(l, job->tmp[0] + lo[0], n[0], bits);
+      sort_rows(r, job->tmp[1] + lo[1], n[1], bits);
+    }
+    job->offset[b] = merge_rows(l, n[0], r, n[1], job->mode, NULL);
+  }
+}
+
+static int join_run(JoinJob *job, const uint32_t *left, size_t nl,
+                    const uint32_t *right, size_t nr, unsigned threads,
+                    overflow_join_pair **pairs, size_t *npairs) {
+  const overflow_vec_ops *ops = overflow_vec_best();
+  uint32_t min_l = ops->min_u32(left, nl), min_r = ops->min_u32(right, nr);
+  uint32_t base = min_l < min_r ? min_l : min_r;
+
+  if (partition_column(left, nl, base, job->sub_bits, job->start[0],
+                       job->rows[0]) ||
+      partition_column(right, nr, base, job->sub_bits, job->start[1],
+                       job->rows[1]))
+    return -1;
+
+  atomic_store(&job->next, 0);
+  overflow_parallel_run(threads, join_worker, job);
+
+  size_t total = 0;
+  for (unsigned b = 0; b < job->nbins; ++b) {
+    size_t c = job->offset[b];
+    job->offset[b] = total;
+    total += c;
+  }
+  job->offset[job->nbins] = total;
+  if (total == 0)
+    return 0;
+
+  job->out = malloc(total * sizeof(overflow_join_pair));
+  if (!job->out)
+    return -1;
+  atomic_store(&job->next, 0);
+  overflow_parallel_run(threads, join_worker, job);
+  *pairs = job->out;
+  *npairs = total;
+  return 0;
+}
+
+int overflow_join_u32(const uint32_t *left, size_t nl, const uint32_t *right,
+                      size_t nr, unsigned mode, unsigned threads,
+                      overflow_join_pair **pairs, size_t *npairs) {
+  *pairs = NULL;
+  *npairs = 0;
+  if (nl > UINT32_MAX || nr > UINT32_MAX)
+    return -1;
+  if (nl == 0 || nr == 0)
+    return 0;
+
+  JoinJob job = {.mode = mode, .sub_bits = OVERFLOW_JOIN_SUB_BITS};
+  job.nbins = OVERFLOW_LOGLIN_BINS_U32(job.sub_bits);
+  JoinRow *rows = malloc((nl + nr) * sizeof(JoinRow));
+  JoinRow *tmp = malloc((nl + nr) * sizeof(JoinRow));
+  size_t *start = malloc(2 * (job.nbins + 1) * sizeof(size_t));
+  job.offset = malloc((job.nbins + 1) * sizeof(size_t));
+  int rc = -1;
+
+  if (rows && tmp && start && job.offset) {
+    job.rows[0] = rows;
+    job.rows[1] = rows + nl;
+    job.tmp[0] = tmp;
+    job.tmp[1] = tmp + nl;
+    job.start[0] = start;
+    job.start[1] = start + job.nbins + 1;
+    rc = join_run(&job, left, nl, right, nr,
+                  overflow_parallel_team_size(nl + nr, threads), pairs,
+                  npairs);
+  }
+
+  free(rows);
+  free(tmp);
+  free(start);
+  free(job.offset);
+  return rc;
+}
@@ -0,0 +1,45 @@
+/**
+ * @file overflow_join.h
+ * @brief Partitioned sort-merge equi-join of two uint32_t key columns.
+ *
+ * Both columns are rebased on their common minimum and scattered into the
+ * same log-linear bins (overflow_tick.h), so equal keys always land in
+ * matching partitions and each partition spans a small key range. Every
+ * partition pair is then radix sorted over its few varying bits and merged
+ * on its own, with the partitions handed out to a team of workers. The
+ * output is counted first and written in a second round, so each partition
+ * writes straight into its final slot.
+ *
+ * Pairs come out by ascending key, then left index, then right index.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#ifndef OVERFLOW_JOIN_H
+#define OVERFLOW_JOIN_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define OVERFLOW_JOIN_SUB_BITS 6 // Log-linear sub-bits of the partitions
+
+// Join modes
+#define OVERFLOW_JOIN_INNER 0 // Every matching (left, right) pair
+#define OVERFLOW_JOIN_SEMI 1  // Each matching left row once
+
+typedef struct {
+  uint32_t left, right; // Row indices into the two key columns
+} overflow_join_pair;
+
+// Joins left[0..nl) and right[0..nr) on equal keys with up to `threads`
+// workers (0 = all online CPUs). On success *pairs is a malloc'd array of
+// *npairs pairs (NULL if there are none) that the caller frees. In semi
+// mode each pair names the first matching right row. Returns 0, or -1 if
+// allocation fails or a column has more than UINT32_MAX rows.
+int overflow_join_u32(const uint32_t *left, size_t nl, const uint32_t *right,
+                      size_t nr, unsigned mode, unsigned threads,
+                      overflow_join_pair **pairs, size_t *npairs);
+
+#endif
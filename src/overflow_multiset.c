@@ -0,0 +1,407 @@
+/**
+ * @file overflow_multiset.c
+ * @brief Ordered multiset of uint32_t keys with rank and select.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include "overflow_multiset.h"
+#include "overflow_engine.h"
+#include "overflow_tick.h"
+#include "overflow_vec.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define BLOCK_MAX OVERFLOW_MULTISET_BLOCK
+#define BLOCK_FILL (BLOCK_MAX * 3 / 4) // Split blocks leave room to grow
+
+typedef struct {
+  uint32_t n;
+  uint32_t keys[BLOCK_MAX];
+} Block;
+
+// Blocks are ordered: every key of blocks[j] is <= every key of
+// blocks[j + 1]. None is empty.
+typedef struct {
+  Block **blocks;
+  uint32_t *last; // Last key of each block, searched instead of the blocks
+  size_t nblocks;
+  size_t cap;
+  size_t *tree; // Fenwick tree of block sizes, 1-based
+  size_t size;  // Keys in the bucket
+  int dirty;    // Blocks were added or removed; tree needs a rebuild
+} Bucket;
+
+struct overflow_multiset {
+  Bucket bucket[OVERFLOW_TICKS_U32];
+  size_t size;
+  const overflow_vec_ops *vec;
+  uint32_t *batch; // Sorted copy of the batch being applied
+  uint32_t *scratch;
+  size_t batch_cap;
+  uint32_t *merged; // A block merged with its share of an insert batch
+  size_t merged_cap;
+};
+
+static int reserve(uint32_t **buf, size_t *cap, size_t n) {
+  if (n <= *cap)
+    return 0;
+  size_t want = *cap ? *cap : 1024;
+  while (want < n)
+    want *= 2;
+  uint32_t *grown = realloc(*buf, want * sizeof(uint32_t));
+  if (!grown)
+    return -1;
+  *buf = grown;
+  *cap = want;
+  return 0;
+}
+
+overflow_multiset *overflow_multiset_create(void) {
+  overflow_multiset *ms = calloc(1, sizeof(overflow_multiset));
+  if (ms)
+    ms->vec = overflow_vec_best();
+  return ms;
+}
+
+void overflow_multiset_destroy(overflow_multiset *ms) {
+  if (!ms)
+    return;
+  for (int t = 0; t < OVERFLOW_TICKS_U32; ++t) {
+    Bucket *b = &ms->bucket[t];
+    for (size_t j = 0; j < b->nblocks; ++j)
+      free(b->blocks[j]);
+    free(b->blocks);
+    free(b->last);
+    free(b->tree);
+  }
+  free(ms->batch);
+  free(ms->scratch);
+  free(ms->merged);
+  free(ms);
+}
+
+// First block at or after `from` whose last key is >= v, or the last block.
+static size_t find_block(const Bucket *b, uint32_t v, size_t from) {
+  size_t lo = from, hi = b->nblocks - 1;
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    if (b->last[mid] < v)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+static void tree_add(Bucket *b, size_t j, size_t delta, int negative) {
+  for (size_t i = j + 1; i <= b->nblocks; i += i & -i)
+    b->tree[i] = negative ? b->tree[i] - delta : b->tree[i] + delta;
+}
+
+static void tree_rebuild(Bucket *b) {
+  for (size_t i = 1; i <= b->nblocks; ++i)
+    b->tree[i] = b->blocks[i - 1]->n;
+  for (size_t i = 1; i <= b->nblocks; ++i) {
+    size_t up = i + (i & -i);
+    if (up <= b->nblocks)
+      b->tree[up] += b->tree[i];
+  }
+  b->dirty = 0;
+}
+
+// Keys in blocks [0, j).
+static size_t tree_prefix(const Bucket *b, size_t j) {
+  size_t sum = 0;
+  for (size_t i = j; i > 0; i -= i & -i)
+    sum += b->tree[i];
+  return sum;
+}
+
+// Block holding the key of rank *k in the bucket; *k becomes its rank
+// inside that block.
+static size_t tree_find(const Bucket *b, size_t *k) {
+  size_t pos = 0, step = 1;
+  while (step * 2 <= b->nblocks)
+    step *= 2;
+  for (; step; step /= 2) {
+    if (pos + step <= b->nblocks && b->tree[pos + step] <= *k) {
+      pos += step;
+      *k -= b->tree[pos];
+    }
+  }
+  return pos;
+}
+
+// Room for `extra` more blocks.
+static int grow_blocks(Bucket *b, size_t extra) {
+  if (b->nblocks + extra <= b->cap)
+    return 0;
+  size_t want = b->cap ? b->cap : 4;
+  while (want < b->nblocks + extra)
+    want *= 2;
+  Block **blocks = realloc(b->blocks, want * sizeof(Block *));
+  if (!blocks)
+    return -1;
+  b->blocks = blocks;
+  uint32_t *last = realloc(b->last, want * sizeof(uint32_t));
+  if (!last)
+    return -1;
+  b->last = last;
+  size_t *tree = realloc(b->tree, (want + 1) * sizeof(size_t));
+  if (!tree)
+    return -1;
+  b->tree = tree;
+  b->cap = want;
+  return 0;
+}
+
+// Replaces block j with keys[0..n), cut into blocks of at most BLOCK_FILL.
+static int split_into(Bucket *b, size_t j, const uint32_t *keys, size_t n) {
+  size_t pieces = (n + BLOCK_FILL - 1) / BLOCK_FILL;
+  if (grow_blocks(b, pieces - 1) != 0)
+    return -1;
+
+  // Allocate every new block before touching the bucket
+  Block **fresh = malloc(pieces * sizeof(Block *));
+  size_t made = 0;
+  while (fresh && made + 1 < pieces &&
+         (fresh[made] = malloc(sizeof(Block))) != NULL)
+    made++;
+  if (!fresh || made + 1 < pieces) {
+    while (fresh && made > 0)
+      free(fresh[--made]);
+    free(fresh);
+    return -1;
+  }
+
+  memmove(&b->blocks[j + pieces], &b->blocks[j + 1],
+          (b->nblocks - j - 1) * sizeof(Block *));
+  memmove(&b->last[j + pieces], &b->last[j + 1],
+          (b->nblocks - j - 1) * sizeof(uint32_t));
+  memcpy(&b->blocks[j + 1], fresh, (pieces - 1) * sizeof(Block *));
+  b->nblocks += pieces - 1;
+  free(fresh);
+
+  // Even sizes, the first pieces taking the remainder
+  size_t from = 0;
+  for (size_t p = 0; p < pieces; ++p) {
+    size_t len = n / pieces + (p < n % pieces);
+    Block *blk = b->blocks[j + p];
+    memcpy(blk->keys, &keys[from], len * sizeof(uint32_t));
+    blk->n = (uint32_t)len;
+    from += len;
+    b->last[j + p] = keys[from - 1];
+  }
+  b->dirty = 1;
+  return 0;
+}
+
+// Merges the sorted run r[0..m) into block j.
+static int merge_block(overflow_multiset *ms, Bucket *b, size_t j,
+                       const uint32_t *r, size_t m) {
+  Block *blk = b->blocks[j];
+  size_t n = blk->n, total = n + m;
+
+  if (total <= BLOCK_MAX) {
+    // Merge from the back in place
+    size_t i = n, k = m, out = total;
+    while (k > 0) {
+      if (i > 0 && blk->keys[i - 1] > r[k - 1])
+        blk->keys[--out] = blk->keys[--i];
+      else
+        blk->keys[--out] = r[--k];
+    }
+    blk->n = (uint32_t)total;
+    b->last[j] = blk->keys[total - 1];
+    if (!b->dirty)
+      tree_add(b, j, m, 0);
+    return 0;
+  }
+
+  if (reserve(&ms->merged, &ms->merged_cap, total) != 0)
+    return -1;
+  size_t i = 0, k = 0, out = 0;
+  while (i < n && k < m)
+    ms->merged[out++] = r[k] < blk->keys[i] ? r[k++] : blk->keys[i++];
+  memcpy(&ms->merged[out], &blk->keys[i], (n - i) * sizeof(uint32_t));
+  out += n - i;
+  memcpy(&ms->merged[out], &r[k], (m - k) * sizeof(uint32_t));
+  return split_into(b, j, ms->merged, total);
+}
+
+static int bucket_insert(overflow_multiset *ms, Bucket *b, const uint32_t *r,
+                         size_t m) {
+  if (b->nblocks == 0) {
+    if (grow_blocks(b, 1) != 0 || !(b->blocks[0] = malloc(sizeof(Block))))
+      return -1;
+    b->blocks[0]->n = 0;
+    b->nblocks = 1;
+    b->dirty = 1;
+  }
+
+  size_t i = 0, j = 0;
+  while (i < m) {
+    j = find_block(b, r[i], j);
+
+    // The run for block j: keys up to its last, or everything for the last
+    size_t end = m;
+    if (j + 1 < b->nblocks) {
+      end = i + 1;
+      while (end < m && r[end] <= b->last[j])
+        end++;
+    }
+    size_t before = b->nblocks;
+    if (merge_block(ms, b, j, &r[i], end - i) != 0) {
+      if (b->blocks[0]->n == 0) { // Drop the block made for an empty bucket
+        free(b->blocks[0]);
+        b->nblocks = 0;
+      }
+      return -1;
+    }
+    b->size += end - i;
+    ms->size += end - i;
+    j += b->nblocks - before; // Skip the pieces a split just made
+    i = end;
+  }
+  return 0;
+}
+
+// Removes matching keys of the sorted run r[0..m) from the bucket.
+static size_t bucket_erase(Bucket *b, const uint32_t *r, size_t m) {
+  size_t removed = 0, i = 0, j = 0;
+
+  while (i < m && j < b->nblocks) {
+    j = find_block(b, r[i], j);
+    Block *blk = b->blocks[j];
+    size_t end = i;
+    while (end < m && r[end] <= b->last[j])
+      end++;
+    if (end == i)
+      break; // The rest are larger than every key in the bucket
+
+    // Drop one key of the block per equal key in the run
+    size_t k = i, out = 0;
+    for (uint32_t s = 0; s < blk->n; ++s) {
+      uint32_t v = blk->keys[s];
+      while (k < end && r[k] < v)
+        k++;
+      if (k < end && r[k] == v)
+        k++;
+      else
+        blk->keys[out++] = v;
+    }
+    size_t gone = blk->n - out;
+    blk->n = (uint32_t)out;
+    removed += gone;
+    if (out == 0) {
+      free(blk);
+      memmove(&b->blocks[j], &b->blocks[j + 1],
+              (b->nblocks - j - 1) * sizeof(Block *));
+      memmove(&b->last[j], &b->last[j + 1],
+              (b->nblocks - j - 1) * sizeof(uint32_t));
+      b->nblocks--;
+      b->dirty = 1;
+    } else {
+      b->last[j] = blk->keys[out - 1];
+      if (!b->dirty)
+        tree_add(b, j, gone, 1);
+      j++;
+    }
+    // Unmatched copies of the block's last key may sit in the next block
+    i = k;
+  }
+  b->size -= removed;
+  return removed;
+}
+
+// Copies keys[0..n) into ms->batch and sorts them.
+static int sort_batch(overflow_multiset *ms, const uint32_t *keys, size_t n) {
+  size_t cap = ms->batch_cap;
+  if (reserve(&ms->batch, &ms->batch_cap, n) != 0 ||
+      reserve(&ms->scratch, &cap, n) != 0)
+    return -1;
+  memcpy(ms->batch, keys, n * sizeof(uint32_t));
+  overflow_tick_sort_u32(ms->batch, n, ms->scratch);
+  return 0;
+}
+
+int overflow_multiset_insert(overflow_multiset *ms, const uint32_t *keys,
+                             size_t n) {
+  if (sort_batch(ms, keys, n) != 0)
+    return -1;
+
+  // Sorted keys come in runs of one tick each
+  for (size_t i = 0; i < n;) {
+    unsigned t = overflow_tick_u32(ms->batch[i]);
+    size_t end = i + 1;
+    while (end < n && overflow_tick_u32(ms->batch[end]) == t)
+      end++;
+    if (bucket_insert(ms, &ms->bucket[t], &ms->batch[i], end - i) != 0)
+      return -1;
+    i = end;
+  }
+  return 0;
+}
+
+int overflow_multiset_erase(overflow_multiset *ms, const uint32_t *keys,
+                            size_t n, size_t *removed) {
+  size_t total = 0;
+  if (sort_batch(ms, keys, n) != 0)
+    return -1;
+
+  for (size_t i = 0; i < n;) {
+    unsigned t = overflow_tick_u32(ms->batch[i]);
+    size_t end = i + 1;
+    while (end < n && overflow_tick_u32(ms->batch[end]) == t)
+      end++;
+    total += bucket_erase(&ms->bucket[t], &ms->batch[i], end - i);
+    i = end;
+  }
+  ms->size -= total;
+  if (removed)
+    *removed = total;
+  return 0;
+}
+
+size_t overflow_multiset_size(const overflow_multiset *ms) { return ms->size; }
+
+size_t overflow_multiset_rank(overflow_multiset *ms, uint32_t key) {
+  unsigned t = overflow_tick_u32(key);
+  size_t rank = 0;
+  for (unsigned u = 0; u < t; ++u)
+    rank += ms->bucket[u].size;
+
+  Bucket *b = &ms->bucket[t];
+  if (b->nblocks == 0)
+    return rank;
+  if (b->dirty)
+    tree_rebuild(b);
+  size_t j = find_block(b, key, 0);
+  const Block *blk = b->blocks[j];
+  return rank + tree_prefix(b, j) +
+         ms->vec->count_below_u32(blk->keys, blk->n, key);
+}
+
+int overflow_multiset_select(overflow_multiset *ms, size_t k, uint32_t *key) {
+  if (k >= ms->size)
+    return -1;
+  unsigned t = 0;
+  while (k >= ms->bucket[t].size)
+    k -= ms->bucket[t++].size;
+
+  Bucket *b = &ms->bucket[t];
+  if (b->dirty)
+    tree_rebuild(b);
+  size_t j = tree_find(b, &k);
+  *key = b->blocks[j]->keys[k];
+  return 0;
+}
+
+int overflow_multiset_lower_bound(overflow_multiset *ms, uint32_t key,
+                                  uint32_t *out) {
+  return overflow_multiset_select(ms, overflow_multiset_rank(ms, key), out);
+}
@@ -0,0 +1,58 @@
+/**
+ * @file overflow_multiset.h
+ * @brief Ordered multiset of uint32_t keys with rank and select.
+ *
+ * A directory of tick buckets, each holding its keys in small sorted
+ * blocks of up to OVERFLOW_MULTISET_BLOCK keys. An insert or erase binary
+ * searches the bucket's blocks by their last key and edits one block, so
+ * no update moves more than a block. Updates come in batches: the batch is
+ * sorted once and then merged block by block, so each block is searched
+ * and rewritten once per batch instead of once per key. A Fenwick tree of
+ * block sizes per bucket answers rank() and select() in O(log blocks) plus
+ * a vectorized count inside one block.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#ifndef OVERFLOW_MULTISET_H
+#define OVERFLOW_MULTISET_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define OVERFLOW_MULTISET_BLOCK 256 // Keys per block at most
+
+typedef struct overflow_multiset overflow_multiset;
+
+// Returns an empty multiset, or NULL if allocation fails.
+overflow_multiset *overflow_multiset_create(void);
+void overflow_multiset_destroy(overflow_multiset *ms);
+
+// Adds keys[0..n); duplicates are kept. Returns 0, or -1 if allocation
+// fails, in which case a prefix of the sorted batch may have been added.
+int overflow_multiset_insert(overflow_multiset *ms, const uint32_t *keys,
+                             size_t n);
+
+// Removes one occurrence per element of keys[0..n), skipping keys that
+// are not present, and stores the number removed in *removed (may be
+// NULL). Returns 0, or -1 if sorting the batch can't allocate scratch.
+int overflow_multiset_erase(overflow_multiset *ms, const uint32_t *keys,
+                            size_t n, size_t *removed);
+
+size_t overflow_multiset_size(const overflow_multiset *ms);
+
+// Number of keys < key.
+size_t overflow_multiset_rank(overflow_multiset *ms, uint32_t key);
+
+// Stores the key of rank k (0 = smallest) in *key. Returns 0, or -1 if k
+// is not below the size.
+int overflow_multiset_select(overflow_multiset *ms, size_t k, uint32_t *key);
+
+// Stores the smallest key >= key in *out. Returns 0, or -1 if there is
+// none.
+int overflow_multiset_lower_bound(overflow_multiset *ms, uint32_t key,
+                                  uint32_t *out);
+
+#endif
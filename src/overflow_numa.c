@@ -0,0 +1,194 @@
+/**
+ * @file overflow_numa.c
+ * @brief NUMA topology, worker pinning and first-touch placement.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#define _GNU_SOURCE
+#include "overflow_numa.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#define PAGE_KEYS 1024 // uint32_t keys per 4 KiB page
+
+// Appends one numactl CPU list ("0-3,8,10-11") as node `node`.
+static int parse_cpulist(overflow_numa_topology *topo, const char *list,
+                         unsigned node) {
+  const char *p = list;
+
+  while (*p && *p != ';' && *p != '\n') {
+    char *end;
+    long lo = strtol(p, &end, 10);
+    long hi = lo;
+    if (end == p || lo < 0)
+      return -1;
+    p = end;
+    if (*p == '-') {
+      hi = strtol(p + 1, &end, 10);
+      if (end == p + 1 || hi < lo)
+        return -1;
+      p = end;
+    }
+    for (long c = lo; c <= hi && topo->cpus < OVERFLOW_MAX_THREADS; ++c) {
+      topo->cpu[topo->cpus] = (int)c;
+      topo->node[topo->cpus] = node;
+      topo->cpus++;
+    }
+    if (*p == ',')
+      ++p;
+    else if (*p && *p != ';' && *p != '\n')
+      return -1;
+  }
+  return 0;
+}
+
+int overflow_numa_parse(overflow_numa_topology *topo, const char *spec) {
+  memset(topo, 0, sizeof(*topo));
+
+  for (const char *p = spec; *p && topo->nodes < OVERFLOW_MAX_NODES;) {
+    if (parse_cpulist(topo, p, topo->nodes) != 0)
+      return -1;
+    topo->nodes++;
+    p = strchr(p, ';');
+    if (!p)
+      break;
+    ++p;
+  }
+  return topo->cpus ? 0 : -1;
+}
+
+static int detect_sysfs(overflow_numa_topology *topo) {
+  char path[64];
+  char list[1024];
+
+  memset(topo, 0, sizeof(*topo));
+  for (unsigned n = 0; n < OVERFLOW_MAX_NODES; ++n) {
+    snprintf(path, sizeof(path), "/sys/devices/system/node/node%u/cpulist", n);
+    FILE *f = fopen(path, "r");
+    if (!f)
+      continue;
+    int ok = fgets(list, sizeof(list), f) != NULL;
+    fclose(f);
+    // Memory-only nodes have an empty list; skip them
+    if (!ok || list[0] == '\n')
+      continue;
+    if (parse_cpulist(topo, list, topo->nodes) != 0)
+      return -1;
+    topo->nodes++;
+  }
+  return topo->cpus ? 0 : -1;
+}
+
+void overflow_numa_detect(overflow_numa_topology *topo) {
+  const char *spec = getenv("OVERFLOW_NUMA");
+
+  if (spec && *spec && overflow_numa_parse(topo, spec) == 0)
+    return;
+  if (detect_sysfs(topo) == 0)
+    return;
+
+  memset(topo, 0, sizeof(*topo));
+  topo->nodes = 1;
+  topo->cpus = overflow_parallel_threads();
+  for (unsigned i = 0; i < topo->cpus; ++i)
+    topo->cpu[i] = (int)i;
+}
+
+void overflow_numa_plan(const overflow_numa_topology *topo, unsigned threads,
+                        int *cpu, unsigned *node) {
+  // Spread evenly over the CPU list; it is node-ordered, so workers with
+  // neighbouring ids (and neighbouring slices) land on the same node
+  for (unsigned w = 0; w < threads; ++w) {
+    unsigned i = (unsigned)((size_t)w * topo->cpus / threads);
+    cpu[w] = topo->cpu[i];
+    node[w] = topo->node[i];
+  }
+}
+
+int overflow_numa_pin(int cpu) {
+  cpu_set_t set;
+
+  if (cpu < 0 || cpu >= CPU_SETSIZE)
+    return -1;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0 ? 0
+                                                                       : -1;
+}
+
+typedef struct {
+  uint32_t *base;
+  size_t lo;
+  size_t hi;
+  int cpu;
+  int pin;
+} TouchSlice;
+
+static void *touch_slice(void *arg) {
+  TouchSlice *s = arg;
+  if (s->pin)
+    overflow_numa_pin(s->cpu);
+  memset(&s->base[s->lo], 0, (s->hi - s->lo) * sizeof(uint32_t));
+  return NULL;
+}
+
+uint32_t *overflow_numa_alloc_u32(size_t n,
+                                  const overflow_parallel_opts *opts) {
+  overflow_numa_topology topo;
+  int cpu[OVERFLOW_MAX_THREADS];
+  unsigned node[OVERFLOW_MAX_THREADS];
+  TouchSlice slices[OVERFLOW_MAX_THREADS];
+  pthread_t tids[OVERFLOW_MAX_THREADS];
+  unsigned threads = overflow_parallel_team_size(n, opts->threads);
+
+  // mmap so no page has been touched yet
+  uint32_t *ptr = mmap(NULL, n ? n * sizeof(uint32_t) : PAGE_KEYS,
+                       PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+                       -1, 0);
+  if (ptr == MAP_FAILED)
+    return NULL;
+
+  if (opts->topology)
+    topo = *opts->topology;
+  else
+    overflow_numa_detect(&topo);
+  overflow_numa_plan(&topo, threads, cpu, node);
+
+  size_t per = n / threads;
+  for (unsigned w = 0; w < threads; ++w) {
+    slices[w].base = ptr;
+    slices[w].lo = per * w;
+    slices[w].hi = w + 1 == threads ? n : per * (w + 1);
+    slices[w].cpu = cpu[w];
+    slices[w].pin = (opts->placement & OVERFLOW_PLACE_PIN) != 0;
+  }
+
+  // Every slice is touched from its own thread; the caller's affinity is
+  // left alone
+  unsigned started = 0;
+  for (; started < threads; ++started)
+    if (pthread_create(&tids[started], NULL, touch_slice,
+                       &slices[started]) != 0)
+      break;
+  for (unsigned w = started; w < threads; ++w) {
+    // Couldn't spawn: touch from here, unpinned
+    slices[w].pin = 0;
+    touch_slice(&slices[w]);
+  }
+  for (unsigned w = 0; w < started; ++w)
+    pthread_join(tids[w], NULL);
+  return ptr;
+}
+
+void overflow_numa_free(uint32_t *ptr, size_t n) {
+  if (ptr)
+    munmap(ptr, n ? n * sizeof(uint32_t) : PAGE_KEYS);
+}
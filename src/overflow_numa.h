@@ -0,0 +1,59 @@
+/**
+ * @file overflow_numa.h
+ * @brief NUMA topology, worker pinning and first-touch placement.
+ *
+ * The topology comes from /sys/devices/system/node, or from the
+ * OVERFLOW_NUMA environment variable when set. The variable uses numactl CPU
+ * list syntax with one list per node separated by ';', e.g. "0-3,8-11;4-7"
+ * describes two nodes. That makes multi-node plans testable on a single-node
+ * machine: pinning to CPUs that don't exist just fails and the sort carries
+ * on unpinned.
+ *
+ * No libnuma is needed. Memory lands on a node by first touch, i.e. a pinned
+ * worker writes its slice before anyone else does.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#ifndef OVERFLOW_NUMA_H
+#define OVERFLOW_NUMA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "overflow_parallel.h"
+
+#define OVERFLOW_MAX_NODES 64
+
+struct overflow_numa_topology {
+  unsigned nodes;
+  unsigned cpus;
+  int cpu[OVERFLOW_MAX_THREADS];       // CPU ids, grouped by node
+  unsigned node[OVERFLOW_MAX_THREADS]; // Node of cpu[i]
+};
+
+// Parses a ';'-separated list of numactl CPU lists. Returns 0 on success,
+// -1 on a malformed spec.
+int overflow_numa_parse(overflow_numa_topology *topo, const char *spec);
+
+// $OVERFLOW_NUMA, else sysfs, else one node holding every online CPU.
+void overflow_numa_detect(overflow_numa_topology *topo);
+
+// Assigns workers to CPUs in node order so consecutive input slices share
+// a node. cpu[] and node[] receive `threads` entries.
+void overflow_numa_plan(const overflow_numa_topology *topo, unsigned threads,
+                        int *cpu, unsigned *node);
+
+// Pins the calling thread to one CPU. Returns 0 on success, -1 otherwise.
+int overflow_numa_pin(int cpu);
+
+// Maps n keys and has each pinned worker zero the slice it will own when
+// overflow_sort_parallel_opts_u32() sorts n keys with the same opts, so
+// input and scratch start out node-local. Free with overflow_numa_free().
+uint32_t *overflow_numa_alloc_u32(size_t n,
+                                  const overflow_parallel_opts *opts);
+void overflow_numa_free(uint32_t *ptr, size_t n);
+
+#endif
@@ -0,0 +1,204 @@
+/**
+ * @file overflow_packed.c
+ * @brief Sorting of bit-packed, frame-of-reference encoded uint32_t keys.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include "overflow_packed.h"
+#include "overflow_engine.h"
+#include "overflow_tick.h"
+#include "overflow_vec.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define PACKED_BLOCK 1024 // Values per decoded block, a multiple of 32
+#define PACKED_GROUP 32   // Values per group; a group fills `width` words
+
+static inline uint32_t width_mask(unsigned width) {
+  return (uint32_t)(((uint64_t)1 << width) - 1);
+}
+
+// Value i of a packed stream. Never reads past the word holding its last
+// bit.
+static inline uint32_t unpack_one(const uint32_t *words, size_t i,
+                                  unsigned width) {
+  size_t bit = i * width;
+  unsigned shift = bit % 32;
+  uint64_t window = words[bit / 32];
+  if (shift + width > 32)
+    window |= (uint64_t)words[bit / 32 + 1] << 32;
+  return (uint32_t)(window >> shift) & width_mask(width);
+}
+
+// One unpacker per width: with the width a constant, every shift and word
+// index in a group is known at compile time.
+#define UNPACK(W)                                                              \
+  static void unpack_##W(const uint32_t *in, uint32_t base, uint32_t *out,     \
+                         size_t groups) {                                      \
+    for (size_t g = 0; g < groups; ++g, in += W, out += PACKED_GROUP)          \
+      for (unsigned i = 0; i < PACKED_GROUP; ++i)                              \
+        out[i] = base + unpack_one(in, i, W);                                  \
+  }
+
+UNPACK(1) UNPACK(2) UNPACK(3) UNPACK(4) UNPACK(5) UNPACK(6) UNPACK(7)
+UNPACK(8) UNPACK(9) UNPACK(10) UNPACK(11) UNPACK(12) UNPACK(13) UNPACK(14)
+UNPACK(15) UNPACK(16) UNPACK(17) UNPACK(18) UNPACK(19) UNPACK(20) UNPACK(21)
+UNPACK(22) UNPACK(23) UNPACK(24) UNPACK(25) UNPACK(26) UNPACK(27) UNPACK(28)
+UNPACK(29) UNPACK(30) UNPACK(31) UNPACK(32)
+
+typedef void (*unpack_fn)(const uint32_t *in, uint32_t base, uint32_t *out,
+                          size_t groups);
+
+static const unpack_fn unpackers[33] = {
+    NULL,       unpack_1,  unpack_2,  unpack_3,  unpack_4,  unpack_5,
+    unpack_6,   unpack_7,  unpack_8,  unpack_9,  unpack_10, unpack_11,
+    unpack_12,  unpack_13, unpack_14, unpack_15, unpack_16, unpack_17,
+    unpack_18,  unpack_19, unpack_20, unpack_21, unpack_22, unpack_23,
+    unpack_24,  unpack_25, unpack_26, unpack_27, unpack_28, unpack_29,
+    unpack_30,  unpack_31, unpack_32};
+
+// Decodes values [first, first + len) of in, first a multiple of 32, as
+// base + value.
+static void decode_block(const overflow_packed_u32 *in, size_t first,
+                         size_t len, uint32_t base, uint32_t *out) {
+  unsigned w = in->width;
+  size_t groups = len / PACKED_GROUP;
+
+  unpackers[w](in->words + first / PACKED_GROUP * w, base, out, groups);
+  for (size_t i = groups * PACKED_GROUP; i < len; ++i)
+    out[i] = base + unpack_one(in->words, first + i, w);
+}
+
+int overflow_pack_u32(const uint32_t *keys, size_t n, unsigned width,
+                      uint32_t base, uint32_t *words) {
+  if (width < 1 || width > 32)
+    return -1;
+  memset(words, 0, OVERFLOW_PACKED_WORDS(n, width) * sizeof(uint32_t));
+
+  for (size_t i = 0; i < n; ++i) {
+    uint32_t v = keys[i] - base;
+    if (keys[i] < base || (v & ~width_mask(width)))
+      return -1;
+    size_t bit = i * width;
+    unsigned shift = bit % 32;
+    words[bit / 32] |= v << shift;
+    if (shift + width > 32)
+      words[bit / 32 + 1] |= v >> (32 - shift);
+  }
+  return 0;
+}
+
+void overflow_unpack_u32(const overflow_packed_u32 *in, size_t first,
+                         size_t count, uint32_t *out) {
+  // Unaligned head value by value, then whole groups
+  size_t head = (PACKED_GROUP - first % PACKED_GROUP) % PACKED_GROUP;
+  if (head > count)
+    head = count;
+  for (size_t i = 0; i < head; ++i)
+    out[i] = in->base + unpack_one(in->words, first + i, in->width);
+  if (count > head)
+    decode_block(in, first + head, count - head, in->base, out + head);
+}
+
+// Width <= OVERFLOW_PACKED_COUNT_BITS: one counter per possible value.
+static int count_sort(const overflow_packed_u32 *in, uint32_t *out) {
+  size_t range = (size_t)1 << in->width;
+  size_t *counts = calloc(range, sizeof(size_t));
+  uint32_t values[PACKED_BLOCK];
+
+  if (!counts)
+    return -1;
+  for (size_t first = 0; first < in->n; first += PACKED_BLOCK) {
+    size_t len = in->n - first < PACKED_BLOCK ? in->n - first : PACKED_BLOCK;
+    decode_block(in, first, len, 0, values);
+    for (size_t j = 0; j < len; ++j)
+      counts[values[j]]++;
+  }
+
+  for (size_t v = 0; v < range; ++v) {
+    uint32_t key = in->base + (uint32_t)v;
+    for (size_t c = counts[v]; c > 0; --c)
+      *out++ = key;
+  }
+  free(counts);
+  return 0;
+}
+
+// Wider columns: tick histogram of the values, scatter of the decoded keys
+// into scratch, then each bucket refined into out.
+static void tick_sort(const overflow_packed_u32 *in, uint32_t *out,
+                      uint32_t *scratch) {
+  const overflow_vec_ops *ops = overflow_vec_best();
+  unsigned w = in->width;
+  size_t counts[OVERFLOW_TICKS_U32] = {0};
+  size_t offsets[OVERFLOW_TICKS_U32], cursor[OVERFLOW_TICKS_U32];
+  uint32_t values[PACKED_BLOCK];
+  uint8_t ticks[PACKED_BLOCK];
+
+  for (size_t first = 0; first < in->n; first += PACKED_BLOCK) {
+    size_t len = in->n - first < PACKED_BLOCK ? in->n - first : PACKED_BLOCK;
+    decode_block(in, first, len, 0, values);
+    ops->ticks_u32(values, len, ticks);
+    for (size_t j = 0; j < len; ++j)
+      counts[ticks[j]]++;
+  }
+
+  // Values below 2^w have ticks 0..w only
+  size_t sum = 0;
+  for (unsigned t = 0; t <= w; ++t) {
+    offsets[t] = cursor[t] = sum;
+    sum += counts[t];
+  }
+
+  for (size_t first = 0; first < in->n; first += PACKED_BLOCK) {
+    size_t len = in->n - first < PACKED_BLOCK ? in->n - first : PACKED_BLOCK;
+    decode_block(in, first, len, 0, values);
+    ops->ticks_u32(values, len, ticks);
+    for (size_t j = 0; j < len; ++j)
+      scratch[cursor[ticks[j]]++] = in->base + values[j];
+  }
+
+  // Bucket t holds base + [2^(t-1), 2^t); sort the bits that range spans
+  for (unsigned t = 0; t <= w; ++t) {
+    if (counts[t] == 0)
+      continue;
+    uint32_t lo = t ? in->base + (1u << (t - 1)) : in->base;
+    uint32_t hi = t ? in->base + width_mask(t) : in->base;
+    overflow_refine_bucket_u32(&scratch[offsets[t]], &out[offsets[t]],
+                               counts[t], overflow_tick_u32(lo ^ hi) + 1, 0);
+  }
+}
+
+int overflow_packed_sort_u32(const overflow_packed_u32 *in, uint32_t *out,
+                             uint32_t *scratch) {
+  unsigned w = in->width;
+  if (w < 1 || w > 32 || in->base > UINT32_MAX - width_mask(w))
+    return -1;
+
+  if (w <= OVERFLOW_PACKED_COUNT_BITS)
+    return count_sort(in, out);
+  if (w == 32) {
+    // Nothing is packed; the plain engine does one read less
+    memcpy(out, in->words, in->n * sizeof(uint32_t));
+    overflow_tick_sort_u32(out, in->n, scratch);
+  } else {
+    tick_sort(in, out, scratch);
+  }
+  return 0;
+}
+
+int overflow_sort_packed_u32(const overflow_packed_u32 *in, uint32_t *out) {
+  if (in->width <= OVERFLOW_PACKED_COUNT_BITS)
+    return overflow_packed_sort_u32(in, out, NULL);
+
+  uint32_t *scratch = malloc(in->n * sizeof(uint32_t));
+  if (!scratch)
+    return -1;
+  int rc = overflow_packed_sort_u32(in, out, scratch);
+  free(scratch);
+  return rc;
+}
@@ -0,0 +1,64 @@
+/**
+ * @file overflow_packed.h
+ * @brief Sorting of bit-packed, frame-of-reference encoded uint32_t keys.
+ *
+ * A packed column stores key - base in `width` bits per value, LSB-first
+ * in a stream of uint32_t words, so each group of 32 values fills exactly
+ * `width` words. Decoding it into a full array before sorting writes and
+ * re-reads 4 bytes per key that the sort never needed. These entry points
+ * decode 1024 values at a time straight into the tick pass, with one
+ * unpacking routine compiled per width, and the first scatter writes the
+ * decoded keys.
+ *
+ * The width also bounds the key range. Up to OVERFLOW_PACKED_COUNT_BITS
+ * bits every possible value gets a counter, and the output is written as
+ * runs with no scatter at all. Wider columns only have width + 1 tick
+ * buckets, and each bucket is refined over the bits where its rebased
+ * range varies.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#ifndef OVERFLOW_PACKED_H
+#define OVERFLOW_PACKED_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define OVERFLOW_PACKED_COUNT_BITS 16 // Counting sort up to this width
+
+// Words needed for n values of `width` bits.
+#define OVERFLOW_PACKED_WORDS(n, width) (((size_t)(n) * (width) + 31) / 32)
+
+typedef struct {
+  const uint32_t *words; // OVERFLOW_PACKED_WORDS(n, width) words
+  size_t n;              // Values
+  unsigned width;        // Bits per value, 1..32
+  uint32_t base;         // Frame of reference added to every value
+} overflow_packed_u32;
+
+// Packs keys[0..n) as key - base into words. Returns 0, or -1 if width is
+// outside 1..32 or a key is below base or too far above it for the width
+// (words is then only partly written).
+int overflow_pack_u32(const uint32_t *keys, size_t n, unsigned width,
+                      uint32_t base, uint32_t *words);
+
+// Decodes keys [first, first + count) of in into out.
+void overflow_unpack_u32(const overflow_packed_u32 *in, size_t first,
+                         size_t count, uint32_t *out);
+
+// Writes the decoded keys of in to out[0..in->n) in ascending order.
+// scratch must hold in->n keys, unless the width is at most
+// OVERFLOW_PACKED_COUNT_BITS; then it may be NULL and the counters are
+// allocated instead. Returns 0, or -1 if the width is outside 1..32, base
+// plus the largest value of the width overflows uint32_t or the counters
+// can't be allocated.
+int overflow_packed_sort_u32(const overflow_packed_u32 *in, uint32_t *out,
+                             uint32_t *scratch);
+
+// Allocating wrapper; also returns -1 if scratch allocation fails.
+int overflow_sort_packed_u32(const overflow_packed_u32 *in, uint32_t *out);
+
+#endif
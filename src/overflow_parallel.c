@@ -0,0 +1,556 @@
+/**
+ * @file overflow_parallel.c
+ * @brief Multithreaded tick-bucket sort for large uint32_t arrays.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#define _GNU_SOURCE
+#include "overflow_parallel.h"
+#include "overflow_engine.h"
+#include "overflow_numa.h"
+#include "overflow_tick.h"
+#include "overflow_vec.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define MIN_KEYS_PER_THREAD 65536
+#define PAGE_KEYS 1024        // uint32_t keys per 4 KiB page
+#define SAMPLE_PER_THREAD 256 // Sampled keys per worker for splitters
+#define SPLIT_OVERSAMPLE 2    // Pieces per n / threads in a skewed tick
+#define SPLIT_BITS 10         // Sub-bins of a skewed tick: 2^SPLIT_BITS
+#define ID_BLOCK 1024         // Keys per block of partition ids
+
+typedef struct {
+  size_t start;
+  size_t size;
+  unsigned tick; // Shared leading bit of every key in the partition
+  unsigned node;
+  atomic_int claimed;
+} Partition;
+
+// Key v of tick t goes to partition lut[base[t] + ((v >> shift[t]) &
+// mask[t])]. A skewed tick is cut into sub-bins by the bits below its
+// leading one, and runs of sub-bins are grouped into partitions at sampled
+// splitters. Other ticks have a single entry, so they stay one partition.
+typedef struct {
+  uint16_t *lut;
+  unsigned base[OVERFLOW_TICKS_U32];
+  unsigned shift[OVERFLOW_TICKS_U32];
+  uint32_t mask[OVERFLOW_TICKS_U32];
+} PartitionMap;
+
+typedef struct {
+  uint32_t *keys;
+  uint32_t *scratch;
+  size_t n;
+  unsigned threads;
+  unsigned flags;
+  unsigned placement;
+  uint32_t base; // Subtracted from every key while sorting (range rebase)
+  uint32_t lo[OVERFLOW_MAX_THREADS], hi[OVERFLOW_MAX_THREADS]; // Per slice
+  pthread_barrier_t barrier;
+  pthread_mutex_t gate_lock; // Workers wait here until the team is known
+  pthread_cond_t gate;
+  int gate_open;
+
+  unsigned parts;
+  PartitionMap map;
+  int skewed; // Some tick was split
+  Partition *part;
+  int *order; // Partitions, largest first
+
+  size_t *hist;   // [threads][parts] per-thread counts, then cursors
+  size_t *local;  // [threads][parts] per-thread piece starts in scratch
+  size_t *cursor; // [threads][parts] scatter write positions
+  atomic_int next_part;
+  int cpu[OVERFLOW_MAX_THREADS];
+  unsigned node[OVERFLOW_MAX_THREADS];
+  atomic_uint pinned;
+} ParallelJob;
+
+typedef struct {
+  ParallelJob *job;
+  unsigned id;
+} Worker;
+
+unsigned overflow_parallel_threads(void) {
+  long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+  if (cpus < 1)
+    return 1;
+  return cpus > OVERFLOW_MAX_THREADS ? OVERFLOW_MAX_THREADS : (unsigned)cpus;
+}
+
+unsigned overflow_parallel_team_size(size_t n, unsigned threads) {
+  if (threads == 0)
+    threads = overflow_parallel_threads();
+  if (threads > OVERFLOW_MAX_THREADS)
+    threads = OVERFLOW_MAX_THREADS;
+  if (threads > n / MIN_KEYS_PER_THREAD)
+    threads = (unsigned)(n / MIN_KEYS_PER_THREAD);
+  return threads ? threads : 1;
+}
+
+typedef struct {
+  void (*fn)(void *arg, unsigned id);
+  void *arg;
+  unsigned id;
+} RunTask;
+
+static void *run_task(void *p) {
+  RunTask *task = p;
+  task->fn(task->arg, task->id);
+  return NULL;
+}
+
+void overflow_parallel_run(unsigned threads, void (*fn)(void *arg, unsigned id),
+                           void *arg) {
+  pthread_t tids[OVERFLOW_MAX_THREADS];
+  RunTask tasks[OVERFLOW_MAX_THREADS];
+  int spawned[OVERFLOW_MAX_THREADS] = {0};
+
+  if (threads > OVERFLOW_MAX_THREADS)
+    threads = OVERFLOW_MAX_THREADS;
+  for (unsigned i = 1; i < threads; ++i) {
+    tasks[i] = (RunTask){.fn = fn, .arg = arg, .id = i};
+    spawned[i] = pthread_create(&tids[i], NULL, run_task, &tasks[i]) == 0;
+  }
+  fn(arg, 0);
+  for (unsigned i = 1; i < threads; ++i) {
+    if (spawned[i])
+      pthread_join(tids[i], NULL);
+    else
+      fn(arg, i);
+  }
+}
+
+static void slice_bounds(const ParallelJob *job, unsigned w, size_t *lo,
+                         size_t *hi) {
+  size_t per = job->n / job->threads;
+  *lo = per * w;
+  *hi = w + 1 == job->threads ? job->n : *lo + per;
+}
+
+// Range rebase in two runs over the slices: the first takes each slice's
+// bounds, the second (once base is set) subtracts base from its keys.
+static void rebase_worker(void *arg, unsigned id) {
+  ParallelJob *job = arg;
+  size_t lo, hi;
+  slice_bounds(job, id, &lo, &hi);
+  if (job->base)
+    overflow_add_u32(&job->keys[lo], hi - lo, -job->base);
+  else
+    overflow_vec_best()->minmax_u32(&job->keys[lo], hi - lo, &job->lo[id],
+                                    &job->hi[id]);
+}
+
+static size_t *row(const ParallelJob *job, size_t *rows, unsigned w) {
+  return rows + (size_t)w * job->parts;
+}
+
+// Partition ids of a block of keys. Looking them up ahead of the
+// histogram and scatter loops keeps the table loads out of the cursor
+// dependency chain.
+static void part_ids(const PartitionMap *map, const uint32_t *keys,
+                     size_t n, uint16_t *ids) {
+  for (size_t i = 0; i < n; ++i) {
+    uint32_t v = keys[i];
+    unsigned t = overflow_tick_u32(v);
+    ids[i] = map->lut[map->base[t] + ((v >> map->shift[t]) & map->mask[t])];
+  }
+}
+
+// Estimates the tick histogram from a strided, sorted sample. A tick that
+// looks bigger than n / threads (normal data piles into one or two) gets
+// splitters at evenly spaced sample ranks, rounded down to its sub-bins, so
+// it scatters into pieces of about n / (SPLIT_OVERSAMPLE * threads) that
+// workers refine in parallel. Keys too close together to differ in the top
+// SPLIT_BITS bits below the leading one stay in one piece. Runs on the
+// caller before the team starts; a failed sample allocation just leaves
+// every tick whole.
+static void plan_splits(ParallelJob *job, int tick_only) {
+  size_t count[OVERFLOW_TICKS_U32] = {0};
+  size_t samples = (size_t)SAMPLE_PER_THREAD * job->threads;
+  uint32_t *sample =
+      tick_only ? NULL : malloc(2 * samples * sizeof(uint32_t));
+
+  if (sample) {
+    size_t stride = job->n / samples;
+    for (size_t i = 0; i < samples; ++i)
+      sample[i] = job->keys[i * stride + stride / 2];
+    overflow_tick_sort_u32(sample, samples, sample + samples);
+    for (size_t i = 0; i < samples; ++i)
+      count[overflow_tick_u32(sample[i])]++;
+  }
+
+  PartitionMap *map = &job->map;
+  unsigned p = 0, entries = 0;
+  size_t seen = 0;
+  job->skewed = 0;
+  for (unsigned t = 0; t < OVERFLOW_TICKS_U32; ++t) {
+    size_t c = count[t];
+    unsigned bits = 0;
+    if (4 * c * job->threads > 5 * samples && t > 1) // Over 1.25 n / threads
+      bits = t - 1 < SPLIT_BITS ? t - 1 : SPLIT_BITS;
+    map->base[t] = entries;
+    map->shift[t] = bits ? t - 1 - bits : 0;
+    map->mask[t] = (1u << bits) - 1;
+
+    // Sub-bin b opens a new partition when a splitter is <= its lowest key
+    size_t pieces =
+        bits ? (SPLIT_OVERSAMPLE * c * job->threads + samples - 1) / samples
+             : 1;
+    size_t next = 1; // First splitter still above the current sub-bin
+    for (uint32_t b = 0; b <= map->mask[t]; ++b) {
+      uint32_t lowest = bits ? 1u << (t - 1) | b << map->shift[t] : 0;
+      size_t passed = next;
+      while (next < pieces && sample[seen + next * c / pieces] <= lowest)
+        next++;
+      if (b > 0 && next > passed)
+        p++;
+      map->lut[entries + b] = (uint16_t)p;
+      job->part[p].tick = t;
+    }
+    job->skewed |= bits > 0;
+    entries += map->mask[t] + 1;
+    p++;
+    seen += c;
+  }
+  job->parts = p;
+  free(sample);
+}
+
+// Partition arrays sized for the most pieces plan_splits() can make.
+static int alloc_plan(ParallelJob *job) {
+  size_t most = 2 * OVERFLOW_TICKS_U32 + SPLIT_OVERSAMPLE * job->threads;
+  job->map.lut = malloc((OVERFLOW_TICKS_U32 << SPLIT_BITS) * sizeof(uint16_t));
+  job->part = malloc(most * sizeof(Partition));
+  job->order = malloc(most * sizeof(int));
+  job->hist = malloc(3 * most * job->threads * sizeof(size_t));
+  return job->map.lut && job->part && job->order && job->hist ? 0 : -1;
+}
+
+static void free_plan(ParallelJob *job) {
+  free(job->map.lut);
+  free(job->part);
+  free(job->order);
+  free(job->hist);
+}
+
+// Turns per-thread histograms into per-thread write cursors and orders the
+// partitions for refinement. Runs on one worker between barriers.
+static void plan_scatter(ParallelJob *job) {
+  size_t sum = 0;
+  for (unsigned p = 0; p < job->parts; ++p) {
+    job->part[p].start = sum;
+    for (unsigned w = 0; w < job->threads; ++w) {
+      size_t *hist = row(job, job->hist, w);
+      size_t c = hist[p];
+      hist[p] = sum;
+      sum += c;
+    }
+    job->part[p].size = sum - job->part[p].start;
+    job->order[p] = (int)p;
+  }
+
+  // Largest partitions go first so the tail of the refine phase is short
+  for (unsigned i = 1; i < job->parts; ++i) {
+    int b = job->order[i];
+    unsigned j = i;
+    while (j > 0 && job->part[job->order[j - 1]].size < job->part[b].size) {
+      job->order[j] = job->order[j - 1];
+      --j;
+    }
+    job->order[j] = b;
+  }
+  atomic_store(&job->next_part, 0);
+}
+
+// Local-placement plan: each worker's pieces sit partition-ordered in the
+// scratch behind its own slice, and each partition is owned by the node
+// that holds most of its final output range.
+static void plan_local(ParallelJob *job) {
+  for (unsigned w = 0; w < job->threads; ++w) {
+    size_t lo, hi;
+    slice_bounds(job, w, &lo, &hi);
+    for (unsigned p = 0; p < job->parts; ++p) {
+      row(job, job->local, w)[p] = lo;
+      lo += row(job, job->hist, w)[p];
+    }
+  }
+  plan_scatter(job);
+
+  for (unsigned p = 0; p < job->parts; ++p) {
+    size_t start = job->part[p].start;
+    size_t end = start + job->part[p].size;
+    size_t best = 0;
+    job->part[p].node = job->node[0];
+    for (unsigned w = 0; w < job->threads; ++w) {
+      size_t lo, hi;
+      slice_bounds(job, w, &lo, &hi);
+      size_t a = lo > start ? lo : start;
+      size_t b = hi < end ? hi : end;
+      if (b > a && b - a > best) {
+        best = b - a;
+        job->part[p].node = job->node[w];
+      }
+    }
+    atomic_store(&job->part[p].claimed, 0);
+  }
+}
+
+static void refine_shared(ParallelJob *job) {
+  for (;;) {
+    int i = atomic_fetch_add(&job->next_part, 1);
+    if (i >= (int)job->parts)
+      break;
+    const Partition *part = &job->part[job->order[i]];
+    if (part->size == 0)
+      break;
+    overflow_refine_bucket_u32(&job->scratch[part->start],
+                               &job->keys[part->start], part->size,
+                               part->tick, job->flags);
+    if (job->base)
+      overflow_add_u32(&job->keys[part->start], part->size, job->base);
+  }
+}
+
+// Copies the part of every worker's pieces that belongs in this worker's
+// slice of the output. Reads may be remote but are sequential.
+static void gather_slice(ParallelJob *job, unsigned id) {
+  size_t lo, hi;
+  slice_bounds(job, id, &lo, &hi);
+
+  for (unsigned v = 0; v < job->threads; ++v) {
+    size_t v_lo, v_hi;
+    slice_bounds(job, v, &v_lo, &v_hi);
+    const size_t *local = row(job, job->local, v);
+    const size_t *hist = row(job, job->hist, v);
+    for (unsigned p = 0; p < job->parts; ++p) {
+      size_t from = local[p];
+      size_t len = (p + 1 < job->parts ? local[p + 1] : v_hi) - from;
+      size_t dst = hist[p];
+      size_t a = dst > lo ? dst : lo;
+      size_t b = dst + len < hi ? dst + len : hi;
+      if (b > a)
+        memcpy(&job->keys[a], &job->scratch[from + (a - dst)],
+               (b - a) * sizeof(uint32_t));
+    }
+  }
+}
+
+static void refine_local(ParallelJob *job, unsigned id) {
+  // First pass takes this node's partitions, second pass steals the rest
+  for (int pass = 0; pass < 2; ++pass) {
+    for (unsigned i = 0; i < job->parts; ++i) {
+      Partition *part = &job->part[job->order[i]];
+      if (part->size == 0)
+        break;
+      if (pass == 0 && part->node != job->node[id])
+        continue;
+      if (atomic_exchange(&part->claimed, 1))
+        continue;
+      overflow_refine_inplace_u32(&job->keys[part->start],
+                                  &job->scratch[part->start], part->size,
+                                  part->tick, job->flags);
+      if (job->base)
+        overflow_add_u32(&job->keys[part->start], part->size, job->base);
+    }
+  }
+}
+
+static void *parallel_worker(void *arg) {
+  Worker *w = arg;
+  ParallelJob *job = w->job;
+
+  pthread_mutex_lock(&job->gate_lock);
+  while (!job->gate_open)
+    pthread_cond_wait(&job->gate, &job->gate_lock);
+  pthread_mutex_unlock(&job->gate_lock);
+  if (w->id >= job->threads)
+    return NULL;
+
+  if ((job->placement & OVERFLOW_PLACE_PIN) &&
+      overflow_numa_pin(job->cpu[w->id]) == 0)
+    atomic_fetch_add(&job->pinned, 1);
+
+  size_t lo, hi;
+  slice_bounds(job, w->id, &lo, &hi);
+  int local = (job->placement & OVERFLOW_PLACE_LOCAL) != 0;
+
+  // Fault in this worker's scratch slice from its own CPU
+  if (job->placement & OVERFLOW_PLACE_FIRST_TOUCH)
+    for (size_t i = lo; i < hi; i += PAGE_KEYS)
+      job->scratch[i] = 0;
+
+  const uint32_t *keys = job->keys;
+  uint32_t *scratch = job->scratch;
+  uint16_t ids[ID_BLOCK];
+  size_t *hist = row(job, job->hist, w->id);
+  if (job->skewed) {
+    memset(hist, 0, job->parts * sizeof(size_t));
+    for (size_t base = lo; base < hi; base += ID_BLOCK) {
+      size_t len = hi - base < ID_BLOCK ? hi - base : ID_BLOCK;
+      part_ids(&job->map, &keys[base], len, ids);
+      for (size_t j = 0; j < len; ++j)
+        hist[ids[j]]++;
+    }
+  } else {
+    overflow_tick_histogram_u32(&keys[lo], hi - lo, hist);
+  }
+  if (pthread_barrier_wait(&job->barrier) == PTHREAD_BARRIER_SERIAL_THREAD) {
+    if (local)
+      plan_local(job);
+    else
+      plan_scatter(job);
+  }
+  pthread_barrier_wait(&job->barrier);
+
+  // Local mode scatters into this worker's own scratch slice
+  size_t *cursor = row(job, job->cursor, w->id);
+  memcpy(cursor, local ? row(job, job->local, w->id) : hist,
+         job->parts * sizeof(size_t));
+  if (job->skewed) {
+    for (size_t base = lo; base < hi; base += ID_BLOCK) {
+      size_t len = hi - base < ID_BLOCK ? hi - base : ID_BLOCK;
+      part_ids(&job->map, &keys[base], len, ids);
+      for (size_t j = 0; j < len; ++j)
+        scratch[cursor[ids[j]]++] = keys[base + j];
+    }
+  } else {
+    for (size_t i = lo; i < hi; ++i)
+      scratch[cursor[overflow_tick_u32(keys[i])]++] = keys[i];
+  }
+  pthread_barrier_wait(&job->barrier);
+
+  if (local) {
+    gather_slice(job, w->id);
+    pthread_barrier_wait(&job->barrier);
+    refine_local(job, w->id);
+  } else {
+    refine_shared(job);
+  }
+  return NULL;
+}
+
+int overflow_sort_parallel_opts_u32(uint32_t *keys, size_t n,
+                                    uint32_t *scratch,
+                                    const overflow_parallel_opts *opts) {
+  unsigned threads = overflow_parallel_team_size(n, opts->threads);
+
+  if (opts->stats) {
+    memset(opts->stats, 0, sizeof(*opts->stats));
+    opts->stats->threads = opts->stats->nodes = 1;
+    opts->stats->partitions = 1;
+    opts->stats->imbalance = 1.0;
+  }
+
+  pthread_t tids[OVERFLOW_MAX_THREADS];
+  Worker workers[OVERFLOW_MAX_THREADS];
+  ParallelJob job = {.keys = keys,
+                     .scratch = scratch,
+                     .n = n,
+                     .threads = threads,
+                     .flags = opts->flags,
+                     .placement = opts->placement};
+
+  // Without scratch for the plan the sort falls back to one worker
+  if (threads <= 1 || alloc_plan(&job) != 0) {
+    free_plan(&job);
+    overflow_tick_sort_flags_u32(keys, n, scratch, opts->flags);
+    return 0;
+  }
+
+  // Range rebase, as in overflow_tick_sort_flags_u32(). The splitters are
+  // sampled before the team's histogram pass, so the bounds take a
+  // parallel pass of their own here.
+  uint32_t lo = UINT32_MAX, hi = 0;
+  overflow_parallel_run(threads, rebase_worker, &job);
+  for (unsigned w = 0; w < threads; ++w) {
+    lo = job.lo[w] < lo ? job.lo[w] : lo;
+    hi = job.hi[w] > hi ? job.hi[w] : hi;
+  }
+  if (lo == hi) {
+    free_plan(&job);
+    return 0; // All keys equal
+  }
+  if (overflow_tick_u32(hi - lo) < overflow_tick_u32(hi)) {
+    job.base = lo;
+    overflow_parallel_run(threads, rebase_worker, &job);
+  }
+  plan_splits(&job, opts->tick_only);
+  job.local = job.hist + (size_t)threads * job.parts;
+  job.cursor = job.local + (size_t)threads * job.parts;
+
+  if (job.placement) {
+    overflow_numa_topology topo;
+    if (opts->topology)
+      topo = *opts->topology;
+    else
+      overflow_numa_detect(&topo);
+    overflow_numa_plan(&topo, threads, job.cpu, job.node);
+  }
+
+  // Worker 0 runs on the calling thread; keep its affinity to restore later
+  cpu_set_t caller_set;
+  int restore = (job.placement & OVERFLOW_PLACE_PIN) &&
+                pthread_getaffinity_np(pthread_self(), sizeof(caller_set),
+                                       &caller_set) == 0;
+
+  pthread_mutex_init(&job.gate_lock, NULL);
+  pthread_cond_init(&job.gate, NULL);
+
+  // If a spawn fails the team simply shrinks to the workers that did start
+  unsigned started = 1;
+  for (unsigned i = 0; i < threads; ++i) {
+    workers[i].job = &job;
+    workers[i].id = i;
+  }
+  for (; started < threads; ++started)
+    if (pthread_create(&tids[started], NULL, parallel_worker,
+                       &workers[started]) != 0)
+      break;
+
+  job.threads = started;
+  pthread_barrier_init(&job.barrier, NULL, started);
+  pthread_mutex_lock(&job.gate_lock);
+  job.gate_open = 1;
+  pthread_cond_broadcast(&job.gate);
+  pthread_mutex_unlock(&job.gate_lock);
+
+  parallel_worker(&workers[0]);
+  for (unsigned i = 1; i < started; ++i)
+    pthread_join(tids[i], NULL);
+  pthread_barrier_destroy(&job.barrier);
+  pthread_cond_destroy(&job.gate);
+  pthread_mutex_destroy(&job.gate_lock);
+
+  if (restore)
+    pthread_setaffinity_np(pthread_self(), sizeof(caller_set), &caller_set);
+
+  if (opts->stats) {
+    opts->stats->threads = started;
+    opts->stats->pinned = atomic_load(&job.pinned);
+    for (unsigned w = 1; w < started; ++w)
+      if (job.node[w] != job.node[w - 1])
+        opts->stats->nodes++;
+    opts->stats->partitions = job.parts;
+    opts->stats->imbalance =
+        (double)job.part[job.order[0]].size * started / (double)n;
+  }
+  free_plan(&job);
+  return 0;
+}
+
+int overflow_sort_parallel_u32(uint32_t *keys, size_t n, uint32_t *scratch,
+                               unsigned threads) {
+  overflow_parallel_opts opts = {.threads = threads};
+  return overflow_sort_parallel_opts_u32(keys, n, scratch, &opts);
+}
@@ -0,0 +1,82 @@
+/**
+ * @file overflow_parallel.h
+ * @brief Multithreaded tick-bucket sort for large uint32_t arrays.
+ *
+ * Each worker histograms its slice by tick, the per-thread histograms are
+ * prefix-summed into private write cursors, every worker scatters its slice
+ * into the shared scratch buffer, and finally the tick buckets are refined
+ * in parallel.
+ *
+ * A strided sample taken first estimates the tick histogram. Ticks holding
+ * more than n / threads keys, such as the one or two that take most of a
+ * normal distribution, are split at sampled splitters into several
+ * partitions, so no single refinement outlasts the rest of the team.
+ *
+ * With OVERFLOW_PLACE_LOCAL each worker instead scatters into the scratch
+ * behind its own input slice, so the random writes stay on its node. The
+ * buckets are then gathered back with sequential block copies, and each
+ * bucket is refined by a worker on the node that holds most of its output
+ * range. Only the histogram prefix sums and that one streaming gather cross
+ * sockets.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#ifndef OVERFLOW_PARALLEL_H
+#define OVERFLOW_PARALLEL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define OVERFLOW_MAX_THREADS 256
+
+// Placement controls
+#define OVERFLOW_PLACE_PIN 0x1         // Pin each worker to one CPU
+#define OVERFLOW_PLACE_LOCAL 0x2       // Node-local scatter and refinement
+#define OVERFLOW_PLACE_FIRST_TOUCH 0x4 // Workers fault their scratch slice
+#define OVERFLOW_PLACE_NUMA                                                    \
+  (OVERFLOW_PLACE_PIN | OVERFLOW_PLACE_LOCAL | OVERFLOW_PLACE_FIRST_TOUCH)
+
+typedef struct overflow_numa_topology overflow_numa_topology;
+
+typedef struct {
+  unsigned threads;    // Workers that ran
+  unsigned nodes;      // Distinct nodes in the worker plan
+  unsigned pinned;     // Workers whose affinity call succeeded
+  unsigned partitions; // Scatter partitions: ticks plus split pieces
+  double imbalance;    // Largest partition over n / threads (1 = even)
+} overflow_parallel_stats;
+
+typedef struct {
+  unsigned threads;   // Workers (0 = all online CPUs)
+  unsigned flags;     // Engine flags, e.g. OVERFLOW_STREAM_OUTPUT
+  unsigned placement; // OVERFLOW_PLACE_* bits (0 = leave it to the OS)
+  int tick_only;      // Don't split skewed ticks (partition by tick alone)
+  const overflow_numa_topology *topology; // NULL = overflow_numa_detect()
+  overflow_parallel_stats *stats;         // Optional, filled on return
+} overflow_parallel_opts;
+
+// Online CPU count, clamped to [1, OVERFLOW_MAX_THREADS].
+unsigned overflow_parallel_threads(void);
+
+// Workers actually used for n keys when `threads` are requested.
+unsigned overflow_parallel_team_size(size_t n, unsigned threads);
+
+// Runs fn(arg, id) for id in [0, threads), id 0 on the calling thread.
+// Ids whose thread cannot be spawned run on the caller afterwards, so every
+// id runs exactly once. For phases with no barrier between workers.
+void overflow_parallel_run(unsigned threads, void (*fn)(void *arg, unsigned id),
+                           void *arg);
+
+// Sorts keys in place with up to `threads` workers (0 = all online CPUs).
+// scratch must hold n keys. Runs with fewer workers if spawning fails.
+// Returns 0 on success.
+int overflow_sort_parallel_u32(uint32_t *keys, size_t n, uint32_t *scratch,
+                               unsigned threads);
+int overflow_sort_parallel_opts_u32(uint32_t *keys, size_t n,
+                                    uint32_t *scratch,
+                                    const overflow_parallel_opts *opts);
+
+#endif
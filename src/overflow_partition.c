@@ -0,0 +1,90 @@
+/**
+ * @file overflow_partition.c
+ * @brief Grouping of uint32_t keys by magnitude class, with no refinement.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include "overflow_partition.h"
+#include "overflow_parallel.h"
+#include "overflow_vec.h"
+
+#include <stdlib.h>
+
+#define PART_BLOCK 1024 // Keys per block of class indices
+
+typedef struct {
+  const overflow_vec_ops *ops;
+  const uint32_t *keys;
+  size_t n;
+  unsigned sub_bits, flags, threads, classes;
+  size_t *cursor; // [threads][classes]: counts, then write cursors
+  uint32_t *out;  // NULL while counting
+} PartitionJob;
+
+// Counts the classes of worker id's slice, or scatters it once out is set.
+static void partition_worker(void *arg, unsigned id) {
+  PartitionJob *job = arg;
+  size_t per = job->n / job->threads;
+  size_t lo = per * id, hi = id + 1 == job->threads ? job->n : lo + per;
+  size_t *cursor = job->cursor + (size_t)id * job->classes;
+  uint16_t bins[PART_BLOCK];
+
+  for (size_t base = lo; base < hi; base += PART_BLOCK) {
+    size_t len = hi - base < PART_BLOCK ? hi - base : PART_BLOCK;
+    const uint32_t *keys = &job->keys[base];
+    job->ops->loglin_u32(keys, len, job->sub_bits, bins);
+    if (!job->out) {
+      for (size_t j = 0; j < len; ++j)
+        cursor[bins[j]]++;
+    } else if (job->flags & OVERFLOW_PARTITION_INDICES) {
+      for (size_t j = 0; j < len; ++j)
+        job->out[cursor[bins[j]]++] = (uint32_t)(base + j);
+    } else {
+      for (size_t j = 0; j < len; ++j)
+        job->out[cursor[bins[j]]++] = keys[j];
+    }
+  }
+}
+
+int overflow_partition_log2(const uint32_t *keys, size_t n,
+                            unsigned sub_bits, unsigned flags,
+                            unsigned threads, uint32_t *out,
+                            size_t *offsets) {
+  if (sub_bits > OVERFLOW_LOGLIN_SUB_MAX)
+    return -1;
+  if ((flags & OVERFLOW_PARTITION_INDICES) && n > UINT32_MAX)
+    return -1;
+
+  PartitionJob job = {.ops = overflow_vec_best(),
+                      .keys = keys,
+                      .n = n,
+                      .sub_bits = sub_bits,
+                      .flags = flags,
+                      .threads = overflow_parallel_team_size(n, threads),
+                      .classes = OVERFLOW_PARTITION_CLASSES(sub_bits)};
+  job.cursor = calloc((size_t)job.threads * job.classes, sizeof(size_t));
+  if (!job.cursor)
+    return -1;
+  overflow_parallel_run(job.threads, partition_worker, &job);
+
+  // Cursors in (class, worker) order keep each class in input order
+  size_t sum = 0;
+  for (unsigned c = 0; c < job.classes; ++c) {
+    offsets[c] = sum;
+    for (unsigned w = 0; w < job.threads; ++w) {
+      size_t *cursor = &job.cursor[(size_t)w * job.classes + c];
+      size_t count = *cursor;
+      *cursor = sum;
+      sum += count;
+    }
+  }
+  offsets[job.classes] = n;
+
+  job.out = out;
+  overflow_parallel_run(job.threads, partition_worker, &job);
+  free(job.cursor);
+  return 0;
+}
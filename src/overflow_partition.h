@@ -0,0 +1,45 @@
+/**
+ * @file overflow_partition.h
+ * @brief Grouping of uint32_t keys by magnitude class, with no refinement.
+ *
+ * Allocators, size-class free lists and request-size histograms only need
+ * keys grouped by power-of-two class, not sorted. This is the engine's
+ * first pass on its own: one vectorized classification, a histogram and a
+ * stable scatter, split across workers by input slice. Classes are the
+ * log-linear bins of overflow_tick.h, so with sub_bits = 0 the class is
+ * the tick, and each extra sub-bit splits every octave in two, doubling
+ * its classes and halving their width.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#ifndef OVERFLOW_PARTITION_H
+#define OVERFLOW_PARTITION_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "overflow_tick.h"
+
+// Partition flags
+#define OVERFLOW_PARTITION_INDICES 0x1 // Write row indices instead of keys
+
+// Classes with 2^sub_bits sub-classes per octave. Values below
+// 2 << sub_bits get one class each.
+#define OVERFLOW_PARTITION_CLASSES(sub_bits) OVERFLOW_LOGLIN_BINS_U32(sub_bits)
+
+// Writes keys[0..n), or their row indices with OVERFLOW_PARTITION_INDICES,
+// to out grouped by class in ascending class order, in input order within
+// a class. Class c is out[offsets[c], offsets[c + 1]); offsets needs
+// OVERFLOW_PARTITION_CLASSES(sub_bits) + 1 entries. Uses up to `threads`
+// workers (0 = all online CPUs). Returns 0, or -1 if sub_bits exceeds
+// OVERFLOW_LOGLIN_SUB_MAX, indices would not fit in uint32_t or
+// allocation fails.
+int overflow_partition_log2(const uint32_t *keys, size_t n,
+                            unsigned sub_bits, unsigned flags,
+                            unsigned threads, uint32_t *out,
+                            size_t *offsets);
+
+#endif
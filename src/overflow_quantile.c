@@ -0,0 +1,174 @@
+/**
+ * @file overflow_quantile.c
+ * @brief Quantiles of uint32_t keys from one log-linear histogram pass.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include "overflow_quantile.h"
+#include "overflow_vec.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BIN_BLOCK 1024 // Keys per block of bin indices
+
+void overflow_loglin_histogram(const uint32_t *keys, size_t n,
+                               unsigned sub_bits, size_t *counts) {
+  const overflow_vec_ops *ops = overflow_vec_best();
+  uint16_t bins[BIN_BLOCK];
+
+  memset(counts, 0, OVERFLOW_LOGLIN_BINS_U32(sub_bits) * sizeof(size_t));
+  for (size_t base = 0; base < n; base += BIN_BLOCK) {
+    size_t len = n - base < BIN_BLOCK ? n - base : BIN_BLOCK;
+    ops->loglin_u32(&keys[base], len, sub_bits, bins);
+    for (size_t j = 0; j < len; ++j)
+      counts[bins[j]]++;
+  }
+}
+
+uint32_t overflow_loglin_lower(unsigned bin, unsigned sub_bits) {
+  if (bin < 2u << sub_bits)
+    return bin;
+  unsigned shift = (bin >> sub_bits) - 1;
+  return (bin - (shift << sub_bits)) << shift;
+}
+
+uint64_t overflow_loglin_width(unsigned bin, unsigned sub_bits) {
+  if (bin < 2u << sub_bits)
+    return 1;
+  return (uint64_t)1 << ((bin >> sub_bits) - 1);
+}
+
+// Returns the k-th smallest of keys[0..n), reordering them. Three-way
+// partitions, so heavy duplicates finish in a pass.
+static uint32_t select_u32(uint32_t *keys, size_t n, size_t k) {
+  while (n > 1) {
+    uint32_t a = keys[0], b = keys[n / 2], c = keys[n - 1];
+    uint32_t pivot = a < b ? (b < c ? b : a < c ? c : a)
+                           : (a < c ? a : b < c ? c : b);
+
+    // [0, lt) < pivot, [lt, gt) == pivot, [gt, n) > pivot
+    size_t lt = 0, i = 0, gt = n;
+    while (i < gt) {
+      uint32_t v = keys[i];
+      if (v < pivot) {
+        keys[i++] = keys[lt];
+        keys[lt++] = v;
+      } else if (v > pivot) {
+        keys[i] = keys[--gt];
+        keys[gt] = v;
+      } else {
+        i++;
+      }
+    }
+
+    if (k < lt) {
+      n = lt;
+    } else if (k < gt) {
+      return pivot;
+    } else {
+      keys += gt;
+      k -= gt;
+      n -= gt;
+    }
+  }
+  return keys[0];
+}
+
+// Gathers the keys of every target bin and selects each exact answer.
+static int refine(const uint32_t *keys, size_t n, unsigned s,
+                  const size_t *counts, const unsigned *bin,
+                  const size_t *local, size_t nq, uint32_t *out) {
+  size_t nbins = OVERFLOW_LOGLIN_BINS_U32(s);
+  size_t *offset = malloc(nbins * sizeof(size_t)); // SIZE_MAX = not a target
+  size_t *fill = malloc(nbins * sizeof(size_t));
+  size_t total = 0;
+
+  if (!offset || !fill) {
+    free(offset);
+    free(fill);
+    return -1;
+  }
+  memset(offset, 0xff, nbins * sizeof(size_t));
+  for (size_t i = 0; i < nq; ++i) {
+    if (offset[bin[i]] != SIZE_MAX)
+      continue;
+    offset[bin[i]] = fill[bin[i]] = total;
+    total += counts[bin[i]];
+  }
+
+  uint32_t *gathered = malloc(total * sizeof(uint32_t));
+  if (!gathered) {
+    free(offset);
+    free(fill);
+    return -1;
+  }
+
+  const overflow_vec_ops *ops = overflow_vec_best();
+  uint16_t bins[BIN_BLOCK];
+  for (size_t base = 0; base < n; base += BIN_BLOCK) {
+    size_t len = n - base < BIN_BLOCK ? n - base : BIN_BLOCK;
+    ops->loglin_u32(&keys[base], len, s, bins);
+    for (size_t j = 0; j < len; ++j)
+      if (offset[bins[j]] != SIZE_MAX)
+        gathered[fill[bins[j]]++] = keys[base + j];
+  }
+
+  for (size_t i = 0; i < nq; ++i)
+    out[i] = select_u32(gathered + offset[bin[i]], counts[bin[i]], local[i]);
+
+  free(gathered);
+  free(offset);
+  free(fill);
+  return 0;
+}
+
+int overflow_quantiles(const uint32_t *keys, size_t n, const double *q,
+                       size_t nq, unsigned sub_bits, unsigned flags,
+                       uint32_t *out) {
+  unsigned s = sub_bits < OVERFLOW_LOGLIN_SUB_MAX ? sub_bits
+                                                  : OVERFLOW_LOGLIN_SUB_MAX;
+  size_t nbins = OVERFLOW_LOGLIN_BINS_U32(s);
+
+  if (n == 0)
+    return -1;
+  for (size_t i = 0; i < nq; ++i)
+    if (isnan(q[i]))
+      return -1;
+
+  size_t *counts = malloc(nbins * sizeof(size_t));
+  unsigned *bin = malloc((nq + 1) * sizeof(unsigned));
+  size_t *local = malloc((nq + 1) * sizeof(size_t)); // Rank inside the bin
+  int rc = -1;
+
+  if (counts && bin && local) {
+    overflow_loglin_histogram(keys, n, s, counts);
+    for (size_t i = 0; i < nq; ++i) {
+      double p = q[i] < 0 ? 0 : q[i] > 1 ? 1 : q[i];
+      size_t rank = (size_t)(p * (double)(n - 1) + 0.5);
+
+      // Walk the cumulative counts to the bin holding this rank
+      size_t seen = 0;
+      unsigned b = 0;
+      while (seen + counts[b] <= rank)
+        seen += counts[b++];
+      bin[i] = b;
+      local[i] = rank - seen;
+
+      uint64_t width = overflow_loglin_width(b, s);
+      out[i] = overflow_loglin_lower(b, s) + (uint32_t)((width - 1) / 2);
+    }
+    rc = flags & OVERFLOW_QUANTILE_EXACT
+             ? refine(keys, n, s, counts, bin, local, nq, out)
+             : 0;
+  }
+
+  free(counts);
+  free(bin);
+  free(local);
+  return rc;
+}
@@ -0,0 +1,50 @@
+/**
+ * @file overflow_quantile.h
+ * @brief Quantiles of uint32_t keys from one log-linear histogram pass.
+ *
+ * The overflow tick is a log2 bucket; splitting each tick by the next
+ * `sub_bits` bits below the leading bit (overflow_loglin_u32()) gives an
+ * HDR-style histogram whose bins are at most 2^-sub_bits of their lower
+ * bound wide. One vectorized pass builds it; a quantile is then read off
+ * the cumulative counts as the midpoint of the bin holding its rank, so
+ * the estimate is within 2^-(sub_bits+1) of the true key, relatively,
+ * and exact for keys below 2^(sub_bits+1).
+ *
+ * With OVERFLOW_QUANTILE_EXACT a second pass gathers only the keys of the
+ * bins that hold the requested ranks and selects the exact answer there.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#ifndef OVERFLOW_QUANTILE_H
+#define OVERFLOW_QUANTILE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "overflow_tick.h"
+
+// Quantile flags
+#define OVERFLOW_QUANTILE_EXACT 0x1 // Select exact keys inside target bins
+
+// counts[OVERFLOW_LOGLIN_BINS_U32(sub_bits)] = log-linear histogram of
+// keys[0..n). Histograms of the same sub_bits add up bin by bin.
+void overflow_loglin_histogram(const uint32_t *keys, size_t n,
+                               unsigned sub_bits, size_t *counts);
+
+// Smallest key and number of keys in a log-linear bin.
+uint32_t overflow_loglin_lower(unsigned bin, unsigned sub_bits);
+uint64_t overflow_loglin_width(unsigned bin, unsigned sub_bits);
+
+// For each q[i] in [0, 1], writes to out[i] the key of rank
+// round(q[i] * (n - 1)) in sorted order, or an estimate of it as described
+// above. q[i] outside [0, 1] is clamped, and sub_bits to
+// OVERFLOW_LOGLIN_SUB_MAX. Returns 0, or -1 if n is 0, any q[i] is NaN or
+// scratch allocation fails.
+int overflow_quantiles(const uint32_t *keys, size_t n, const double *q,
+                       size_t nq, unsigned sub_bits, unsigned flags,
+                       uint32_t *out);
+
+#endif
@@ -0,0 +1,270 @@
+/**
+ * @file overflow_runfile.c
+ * @brief Sorted uint32_t keys kept on disk with a log-linear bin directory.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include "overflow_runfile.h"
+#include "overflow_columns.h"
+#include "overflow_engine.h"
+#include "overflow_quantile.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define RUNFILE_MAGIC "OVFRUNS"
+#define RUNFILE_VERSION 1
+#define RUNFILE_PAYLOADS 0x1 // Header flag: payloads follow the keys
+#define RUNFILE_ALIGN 64
+
+typedef struct {
+  char magic[8];
+  uint32_t version; // Reads back differently in the other byte order
+  uint32_t sub_bits;
+  uint64_t n;
+  uint32_t flags;
+  uint32_t reserved;
+} FileHeader;
+
+typedef struct {
+  size_t keys, payloads, bytes; // Offsets of both arrays and file size
+} Layout;
+
+struct overflow_runfile {
+  void *map;
+  size_t bytes;
+  size_t n;
+  unsigned sub_bits;
+  const uint64_t *dir;
+  const uint32_t *keys;
+  const uint32_t *payloads;
+};
+
+static size_t align_up(size_t v) {
+  return (v + RUNFILE_ALIGN - 1) & ~(size_t)(RUNFILE_ALIGN - 1);
+}
+
+static Layout layout(size_t n, unsigned sub_bits, int payloads) {
+  Layout l;
+  size_t dir = (OVERFLOW_LOGLIN_BINS_U32(sub_bits) + 1) * sizeof(uint64_t);
+  l.keys = align_up(sizeof(FileHeader) + dir);
+  l.payloads = align_up(l.keys + n * sizeof(uint32_t));
+  l.bytes = payloads ? l.payloads + n * sizeof(uint32_t)
+                     : l.keys + n * sizeof(uint32_t);
+  return l;
+}
+
+// Sorts the copied keys (and payloads) in the mapping and fills in the
+// directory from their log-linear histogram.
+static int fill(uint8_t *p, const Layout *l, size_t n, unsigned sub_bits,
+                int payloads) {
+  uint32_t *keys = (uint32_t *)(p + l->keys);
+  uint64_t *dir = (uint64_t *)(p + sizeof(FileHeader));
+  unsigned bins = OVERFLOW_LOGLIN_BINS_U32(sub_bits);
+
+  if (payloads) {
+    overflow_column key = {keys, 4, 0};
+    overflow_column payload = {p + l->payloads, 4, 0};
+    if (overflow_sort_columns(&key, 1, &payload, 1, n) != 0)
+      return -1;
+  } else if (overflow_sort_u32(keys, n) != 0) {
+    return -1;
+  }
+
+  size_t *counts = malloc(bins * sizeof(size_t));
+  if (!counts)
+    return -1;
+  overflow_loglin_histogram(keys, n, sub_bits, counts);
+  dir[0] = 0;
+  for (unsigned b = 0; b < bins; ++b)
+    dir[b + 1] = dir[b] + counts[b];
+  free(counts);
+  return 0;
+}
+
+// Syncs the directory holding path, which makes a rename into it durable.
+static int sync_parent(const char *path) {
+  char dir[4096];
+  const char *slash = strrchr(path, '/');
+  size_t len = slash ? (size_t)(slash - path) : 0;
+
+  if (len >= sizeof(dir))
+    return -1;
+  memcpy(dir, path, len);
+  strcpy(dir + len, slash ? (len ? "" : "/") : ".");
+  int fd = open(dir, O_RDONLY | O_DIRECTORY);
+  if (fd < 0)
+    return -1;
+  int rc = fsync(fd) == 0 ? 0 : -1;
+  if (close(fd) != 0)
+    rc = -1;
+  return rc;
+}
+
+int overflow_runfile_write(const char *path, const uint32_t *keys,
+                           const uint32_t *payloads, size_t n,
+                           unsigned sub_bits) {
+  char tmp[4096];
+  unsigned s = sub_bits > OVERFLOW_LOGLIN_SUB_MAX ? OVERFLOW_LOGLIN_SUB_MAX
+                                                  : sub_bits;
+  Layout l = layout(n, s, payloads != NULL);
+
+  // A unique temporary name, so concurrent writers of one path never
+  // share it
+  if (snprintf(tmp, sizeof(tmp), "%s.XXXXXX", path) >= (int)sizeof(tmp))
+    return -1;
+  int fd = mkstemp(tmp);
+  if (fd < 0)
+    return -1;
+  if (fchmod(fd, 0644) != 0) {
+    close(fd);
+    unlink(tmp);
+    return -1;
+  }
+  // Reserve the blocks up front: a full disk then fails here, not as a
+  // SIGBUS while the mapping is written
+  if (posix_fallocate(fd, 0, (off_t)l.bytes) != 0) {
+    close(fd);
+    unlink(tmp);
+    return -1;
+  }
+  uint8_t *p =
+      mmap(NULL, l.bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (p == MAP_FAILED) {
+    close(fd);
+    unlink(tmp);
+    return -1;
+  }
+
+  FileHeader h = {RUNFILE_MAGIC, RUNFILE_VERSION, s, n,
+                  payloads ? RUNFILE_PAYLOADS : 0, 0};
+  memcpy(p, &h, sizeof(h));
+  if (n)
+    memcpy(p + l.keys, keys, n * sizeof(uint32_t));
+  if (n && payloads)
+    memcpy(p + l.payloads, payloads, n * sizeof(uint32_t));
+  int rc = fill(p, &l, n, s, payloads != NULL);
+
+  // The data must be on disk before the rename makes the file visible
+  if (msync(p, l.bytes, MS_SYNC) != 0)
+    rc = -1;
+  if (munmap(p, l.bytes) != 0)
+    rc = -1;
+  if (fsync(fd) != 0)
+    rc = -1;
+  if (close(fd) != 0)
+    rc = -1;
+  if (rc != 0 || rename(tmp, path) != 0) {
+    unlink(tmp);
+    return -1;
+  }
+  return sync_parent(path);
+}
+
+overflow_runfile *overflow_runfile_open(const char *path) {
+  int fd = open(path, O_RDONLY);
+  struct stat st;
+  FileHeader h;
+
+  if (fd < 0)
+    return NULL;
+  if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(h) ||
+      pread(fd, &h, sizeof(h), 0) != (ssize_t)sizeof(h) ||
+      memcmp(h.magic, RUNFILE_MAGIC, sizeof(h.magic)) != 0 ||
+      h.version != RUNFILE_VERSION || h.sub_bits > OVERFLOW_LOGLIN_SUB_MAX ||
+      h.n > SIZE_MAX / (2 * sizeof(uint32_t))) {
+    close(fd);
+    return NULL;
+  }
+  Layout l = layout(h.n, h.sub_bits, h.flags & RUNFILE_PAYLOADS);
+  if ((size_t)st.st_size != l.bytes) {
+    close(fd);
+    return NULL;
+  }
+
+  overflow_runfile *rf = malloc(sizeof(*rf));
+  void *p = rf ? mmap(NULL, l.bytes, PROT_READ, MAP_SHARED, fd, 0)
+               : MAP_FAILED;
+  close(fd);
+  if (p == MAP_FAILED) {
+    free(rf);
+    return NULL;
+  }
+
+  // The last directory entry must account for every key; the rest is
+  // trusted, as the file is never parsed
+  const uint8_t *base = p;
+  const uint64_t *dir = (const uint64_t *)(base + sizeof(FileHeader));
+  if (dir[OVERFLOW_LOGLIN_BINS_U32(h.sub_bits)] != h.n) {
+    munmap(p, l.bytes);
+    free(rf);
+    return NULL;
+  }
+  // Lookups touch a few scattered pages; readahead would only pull in
+  // neighbours they never read
+  madvise(p, l.bytes, MADV_RANDOM);
+  rf->map = p;
+  rf->bytes = l.bytes;
+  rf->n = h.n;
+  rf->sub_bits = h.sub_bits;
+  rf->dir = dir;
+  rf->keys = (const uint32_t *)(base + l.keys);
+  rf->payloads = h.flags & RUNFILE_PAYLOADS
+                     ? (const uint32_t *)(base + l.payloads)
+                     : NULL;
+  return rf;
+}
+
+void overflow_runfile_close(overflow_runfile *rf) {
+  if (!rf)
+    return;
+  munmap(rf->map, rf->bytes);
+  free(rf);
+}
+
+size_t overflow_runfile_size(const overflow_runfile *rf) { return rf->n; }
+
+const uint32_t *overflow_runfile_keys(const overflow_runfile *rf) {
+  return rf->keys;
+}
+
+const uint32_t *overflow_runfile_payloads(const overflow_runfile *rf) {
+  return rf->payloads;
+}
+
+size_t overflow_runfile_lower_bound(const overflow_runfile *rf,
+                                    uint32_t key) {
+  unsigned b = overflow_loglin_u32(key, rf->sub_bits);
+  size_t first = rf->dir[b], len = rf->dir[b + 1] - first;
+
+  // Every key of an earlier bin is smaller and every key of a later one
+  // larger, so only this bin is searched. Bins below 2 << sub_bits hold
+  // the one value key itself.
+  if (len == 0 || b < 2u << rf->sub_bits)
+    return first;
+  const uint32_t *p = rf->keys + first;
+  while (len > 1) {
+    size_t half = len / 2;
+    p = p[half] < key ? p + half : p;
+    len -= half;
+  }
+  return (size_t)(p - rf->keys) + (*p < key);
+}
+
+size_t overflow_runfile_range(const overflow_runfile *rf, uint32_t lo,
+                              uint32_t hi, size_t *first) {
+  *first = overflow_runfile_lower_bound(rf, lo);
+  if (lo > hi)
+    return 0;
+  size_t end = hi == UINT32_MAX ? rf->n
+                                : overflow_runfile_lower_bound(rf, hi + 1);
+  return end - *first;
+}
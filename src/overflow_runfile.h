@@ -0,0 +1,64 @@
+/**
+ * @file overflow_runfile.h
+ * @brief Sorted uint32_t keys kept on disk with a log-linear bin directory.
+ *
+ * A run file holds sorted keys, optional uint32_t payloads and the start
+ * offset of every log-linear bin (overflow_loglin_u32(), see
+ * overflow_tick.h). Opening one is a single mmap and a header check; no
+ * key is read. A lookup reads the two directory entries of the key's bin
+ * and binary searches that bin only, so it touches a few pages of keys
+ * instead of the log2(n) a search over the whole array faults in.
+ *
+ * Layout, in native byte order: a 32-byte header, the directory of
+ * OVERFLOW_LOGLIN_BINS_U32(sub_bits) + 1 uint64_t offsets, then the keys
+ * and the payloads, each starting on a 64-byte boundary.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#ifndef OVERFLOW_RUNFILE_H
+#define OVERFLOW_RUNFILE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define OVERFLOW_RUNFILE_SUB_BITS 10 // Default directory resolution
+
+typedef struct overflow_runfile overflow_runfile;
+
+// Sorts keys[0..n), with payloads[i] carried along with keys[i] when
+// payloads is not NULL, and writes them to path with a directory of
+// sub_bits resolution (clamped to OVERFLOW_LOGLIN_SUB_MAX). The inputs are
+// not modified. The file is written under a unique temporary name, synced
+// and renamed into place, and its directory is synced so the rename
+// survives a crash. Returns 0, or -1 on an I/O or allocation failure
+// (including a full disk). Any existing file at path is left unchanged
+// unless only the final directory sync failed.
+int overflow_runfile_write(const char *path, const uint32_t *keys,
+                           const uint32_t *payloads, size_t n,
+                           unsigned sub_bits);
+
+// Maps a run file read-only, advised for random access (MADV_RANDOM).
+// Returns NULL if it can't be opened or is not a well-formed run file of
+// this byte order.
+overflow_runfile *overflow_runfile_open(const char *path);
+void overflow_runfile_close(overflow_runfile *rf);
+
+size_t overflow_runfile_size(const overflow_runfile *rf);
+
+// The mapped keys, ascending, and payloads (NULL if the file has none).
+const uint32_t *overflow_runfile_keys(const overflow_runfile *rf);
+const uint32_t *overflow_runfile_payloads(const overflow_runfile *rf);
+
+// Index of the first key >= key; the size if there is none.
+size_t overflow_runfile_lower_bound(const overflow_runfile *rf,
+                                    uint32_t key);
+
+// Number of keys in [lo, hi], storing the index of the first in *first.
+// Returns 0 (and *first = lower bound of lo) when lo > hi.
+size_t overflow_runfile_range(const overflow_runfile *rf, uint32_t lo,
+                              uint32_t hi, size_t *first);
+
+#endif
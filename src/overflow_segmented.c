@@ -0,0 +1,60 @@
+/**
+ * @file overflow_segmented.c
+ * @brief Batched sort of many uint32_t segments in one call.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include "overflow_segmented.h"
+#include "overflow_parallel.h"
+
+int overflow_sort_segmented_ctx(overflow_sort_ctx *ctx, uint32_t *keys,
+                                const size_t *offsets, size_t nsegs) {
+  size_t longest = 0;
+
+  // One scratch allocation for the whole batch
+  for (size_t s = 0; s < nsegs; ++s) {
+    size_t len = offsets[s + 1] - offsets[s];
+    if (len > longest)
+      longest = len;
+  }
+
+  uint32_t *scratch = NULL;
+  if (longest > OVERFLOW_INSERTION_MAX) {
+    scratch = overflow_ctx_arena(ctx, OVERFLOW_ARENA_SCRATCH,
+                                 longest * sizeof(uint32_t));
+    if (!scratch)
+      return -1;
+  }
+
+  for (size_t s = 0; s < nsegs; ++s) {
+    uint32_t *seg = &keys[offsets[s]];
+    size_t len = offsets[s + 1] - offsets[s];
+
+    if (len <= OVERFLOW_SEGMENT_TINY)
+      overflow_network_sort_u32(seg, len);
+    else if (len < OVERFLOW_SEGMENT_LARGE)
+      overflow_tick_sort_u32(seg, len, scratch);
+    else
+      overflow_sort_parallel_u32(seg, len, scratch, ctx->threads);
+  }
+  return 0;
+}
+
+int overflow_sort_segmented_threads(uint32_t *keys, const size_t *offsets,
+                                    size_t nsegs, unsigned threads) {
+  overflow_sort_ctx ctx;
+
+  overflow_ctx_init(&ctx);
+  ctx.threads = threads;
+  int rc = overflow_sort_segmented_ctx(&ctx, keys, offsets, nsegs);
+  overflow_ctx_free(&ctx);
+  return rc;
+}
+
+int overflow_sort_segmented(uint32_t *keys, const size_t *offsets,
+                            size_t nsegs) {
+  return overflow_sort_segmented_threads(keys, offsets, nsegs, 0);
+}
@@ -0,0 +1,42 @@
+/**
+ * @file overflow_segmented.h
+ * @brief Batched sort of many uint32_t segments in one call.
+ *
+ * Segments are described CSR-style: segment i is keys[offsets[i] ..
+ * offsets[i + 1]), so offsets holds nsegs + 1 entries. Each segment is sorted
+ * in place and independently of the others. One scratch buffer, sized for the
+ * largest segment, is shared by the whole batch.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#ifndef OVERFLOW_SEGMENTED_H
+#define OVERFLOW_SEGMENTED_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "overflow_ctx.h"
+#include "overflow_engine.h"
+
+// Size classes: tiny segments use the sorting network, medium ones the
+// single-threaded tick sort, large ones the parallel engine.
+#define OVERFLOW_SEGMENT_TINY OVERFLOW_NETWORK_MAX
+#define OVERFLOW_SEGMENT_LARGE (1u << 20)
+
+// Returns 0 on success, -1 if the shared scratch can't be allocated.
+int overflow_sort_segmented(uint32_t *keys, const size_t *offsets,
+                            size_t nsegs);
+
+// Same as above with an explicit worker count for large segments
+// (0 = all online CPUs).
+int overflow_sort_segmented_threads(uint32_t *keys, const size_t *offsets,
+                                    size_t nsegs, unsigned threads);
+
+// Batch sort reusing ctx's scratch; large segments use ctx->threads workers.
+int overflow_sort_segmented_ctx(overflow_sort_ctx *ctx, uint32_t *keys,
+                                const size_t *offsets, size_t nsegs);
+
+#endif
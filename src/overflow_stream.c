@@ -0,0 +1,243 @@
+/**
+ * @file overflow_stream.c
+ * @brief Streaming ingest: sort uint32_t keys while they are still arriving.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include "overflow_stream.h"
+#include "overflow_engine.h"
+#include "overflow_tick.h"
+#include "overflow_vec.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define SEGMENT_MIN 1024 // First allocation of a tick segment, in keys
+
+struct overflow_stream {
+  uint32_t *buf[2];
+  size_t chunk; // Keys per input buffer
+  unsigned cur; // Buffer being filled by the caller
+  size_t used;  // Keys in buf[cur]
+
+  // Per-tick segments, only touched by the scatter side
+  uint32_t *seg[OVERFLOW_TICKS_U32];
+  size_t len[OVERFLOW_TICKS_U32];
+  size_t cap[OVERFLOW_TICKS_U32];
+  size_t count;
+  int failed;
+
+  // Handoff to the worker: at most one buffer is in flight
+  pthread_t worker;
+  int threaded;
+  pthread_mutex_t lock;
+  pthread_cond_t cond;
+  int inflight; // Buffer index, or -1
+  size_t inflight_n;
+  int stop;
+};
+
+// Appends one chunk to the tick segments.
+static void scatter_chunk(overflow_stream *s, const uint32_t *keys, size_t n) {
+  size_t counts[OVERFLOW_TICKS_U32];
+
+  overflow_vec_best()->histogram_u32(keys, n, counts);
+  for (unsigned t = 0; t < OVERFLOW_TICKS_U32; ++t) {
+    size_t need = s->len[t] + counts[t];
+    if (need <= s->cap[t])
+      continue;
+    size_t cap = s->cap[t] ? s->cap[t] : SEGMENT_MIN;
+    while (cap < need)
+      cap *= 2;
+    uint32_t *seg = realloc(s->seg[t], cap * sizeof(uint32_t));
+    if (!seg) {
+      s->failed = 1;
+      return;
+    }
+    s->seg[t] = seg;
+    s->cap[t] = cap;
+  }
+
+  uint32_t *dst[OVERFLOW_TICKS_U32];
+  for (unsigned t = 0; t < OVERFLOW_TICKS_U32; ++t)
+    dst[t] = s->seg[t] + s->len[t];
+  for (size_t i = 0; i < n; ++i)
+    *dst[overflow_tick_u32(keys[i])]++ = keys[i];
+  for (unsigned t = 0; t < OVERFLOW_TICKS_U32; ++t)
+    s->len[t] += counts[t];
+}
+
+static void *stream_worker(void *arg) {
+  overflow_stream *s = arg;
+
+  pthread_mutex_lock(&s->lock);
+  for (;;) {
+    while (s->inflight < 0 && !s->stop)
+      pthread_cond_wait(&s->cond, &s->lock);
+    if (s->inflight < 0)
+      break;
+    int b = s->inflight;
+    size_t n = s->inflight_n;
+    pthread_mutex_unlock(&s->lock);
+
+    if (!s->failed)
+      scatter_chunk(s, s->buf[b], n);
+
+    pthread_mutex_lock(&s->lock);
+    s->inflight = -1;
+    pthread_cond_broadcast(&s->cond);
+  }
+  pthread_mutex_unlock(&s->lock);
+  return NULL;
+}
+
+// Blocks until the worker has no buffer in flight.
+static void wait_idle(overflow_stream *s) {
+  if (!s->threaded)
+    return;
+  pthread_mutex_lock(&s->lock);
+  while (s->inflight >= 0)
+    pthread_cond_wait(&s->cond, &s->lock);
+  pthread_mutex_unlock(&s->lock);
+}
+
+// Hands the current buffer to the worker and switches to the other one,
+// which is free once the previous handoff has been scattered. Returns -1
+// if a scatter has failed so far.
+static int hand_off(overflow_stream *s) {
+  if (s->used == 0)
+    return s->failed ? -1 : 0;
+  if (!s->threaded) {
+    if (!s->failed)
+      scatter_chunk(s, s->buf[s->cur], s->used);
+    s->used = 0;
+    return s->failed ? -1 : 0;
+  }
+
+  wait_idle(s);
+  if (s->failed)
+    return -1;
+  pthread_mutex_lock(&s->lock);
+  s->inflight = (int)s->cur;
+  s->inflight_n = s->used;
+  pthread_cond_broadcast(&s->cond);
+  pthread_mutex_unlock(&s->lock);
+  s->cur ^= 1;
+  s->used = 0;
+  return 0;
+}
+
+overflow_stream *overflow_stream_create(size_t chunk) {
+  overflow_stream *s = calloc(1, sizeof(*s));
+  if (!s)
+    return NULL;
+
+  s->chunk = chunk ? chunk : OVERFLOW_STREAM_CHUNK;
+  s->buf[0] = malloc(s->chunk * sizeof(uint32_t));
+  s->buf[1] = malloc(s->chunk * sizeof(uint32_t));
+  if (!s->buf[0] || !s->buf[1]) {
+    free(s->buf[0]);
+    free(s->buf[1]);
+    free(s);
+    return NULL;
+  }
+
+  s->inflight = -1;
+  pthread_mutex_init(&s->lock, NULL);
+  pthread_cond_init(&s->cond, NULL);
+  s->threaded = pthread_create(&s->worker, NULL, stream_worker, s) == 0;
+  return s;
+}
+
+void overflow_stream_destroy(overflow_stream *s) {
+  if (!s)
+    return;
+  if (s->threaded) {
+    pthread_mutex_lock(&s->lock);
+    s->stop = 1;
+    pthread_cond_broadcast(&s->cond);
+    pthread_mutex_unlock(&s->lock);
+    pthread_join(s->worker, NULL);
+  }
+  pthread_cond_destroy(&s->cond);
+  pthread_mutex_destroy(&s->lock);
+  for (unsigned t = 0; t < OVERFLOW_TICKS_U32; ++t)
+    free(s->seg[t]);
+  free(s->buf[0]);
+  free(s->buf[1]);
+  free(s);
+}
+
+uint32_t *overflow_stream_buffer(overflow_stream *s, size_t *capacity) {
+  *capacity = s->chunk - s->used;
+  return s->buf[s->cur] + s->used;
+}
+
+int overflow_stream_commit(overflow_stream *s, size_t n) {
+  s->used += n;
+  s->count += n;
+  return s->used == s->chunk ? hand_off(s) : 0;
+}
+
+int overflow_stream_push(overflow_stream *s, const uint32_t *keys, size_t n) {
+  while (n > 0) {
+    size_t room;
+    uint32_t *dst = overflow_stream_buffer(s, &room);
+    size_t take = n < room ? n : room;
+    memcpy(dst, keys, take * sizeof(uint32_t));
+    if (overflow_stream_commit(s, take) != 0)
+      return -1;
+    keys += take;
+    n -= take;
+  }
+  return 0;
+}
+
+int overflow_stream_read_fd(overflow_stream *s, int fd) {
+  size_t partial = 0; // Bytes of an incomplete key after the committed ones
+
+  for (;;) {
+    size_t room;
+    uint8_t *dst = (uint8_t *)overflow_stream_buffer(s, &room);
+    ssize_t got = read(fd, dst + partial, room * sizeof(uint32_t) - partial);
+    if (got < 0 && errno == EINTR)
+      continue;
+    if (got < 0)
+      return -1;
+    if (got == 0)
+      return partial ? -1 : 0;
+
+    size_t bytes = partial + (size_t)got;
+    size_t whole = bytes / sizeof(uint32_t);
+    partial = bytes % sizeof(uint32_t);
+    // A partial key stays where the next read continues it; the buffer
+    // can only fill up, and move on, when no partial key is left
+    if (whole && overflow_stream_commit(s, whole) != 0)
+      return -1;
+  }
+}
+
+size_t overflow_stream_count(const overflow_stream *s) { return s->count; }
+
+int overflow_stream_finish(overflow_stream *s, uint32_t *out) {
+  hand_off(s);
+  wait_idle(s);
+
+  int failed = s->failed;
+  size_t offset = 0;
+  for (unsigned t = 0; t < OVERFLOW_TICKS_U32; ++t) {
+    if (!failed && out && s->len[t])
+      overflow_refine_bucket_u32(s->seg[t], out + offset, s->len[t], t, 0);
+    offset += s->len[t];
+    s->len[t] = 0;
+  }
+  s->count = 0;
+  s->failed = 0;
+  return failed ? -1 : 0;
+}
@@ -0,0 +1,60 @@
+/**
+ * @file overflow_stream.h
+ * @brief Streaming ingest: sort uint32_t keys while they are still arriving.
+ *
+ * Keys are pushed in chunks into one of two input buffers. When a buffer
+ * fills it is handed to a background worker, which computes its tick
+ * histogram and appends its keys to growing per-tick segments, while the
+ * caller reads the next chunk into the other buffer. By the time the input
+ * ends only the within-bucket refinement is left, and
+ * overflow_stream_finish() writes each refined bucket straight into the
+ * output array.
+ *
+ * Segments grow geometrically, so peak memory is up to about twice the
+ * keys plus the two input buffers. A finished stream is empty again and
+ * keeps its segments, so reusing it for similar inputs allocates nothing.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#ifndef OVERFLOW_STREAM_H
+#define OVERFLOW_STREAM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define OVERFLOW_STREAM_CHUNK (1u << 20) // Default keys per input buffer
+
+typedef struct overflow_stream overflow_stream;
+
+// Creates a stream whose input buffers hold `chunk` keys (0 = the default).
+// Scatter runs on the caller if the worker thread can't be started.
+// Returns NULL if allocation fails.
+overflow_stream *overflow_stream_create(size_t chunk);
+void overflow_stream_destroy(overflow_stream *s);
+
+// Copies n keys into the stream. Returns 0, or -1 if a segment can't grow.
+int overflow_stream_push(overflow_stream *s, const uint32_t *keys, size_t n);
+
+// Zero-copy ingest: returns the free space of the current input buffer
+// (*capacity keys, at least one), to be filled and then committed.
+uint32_t *overflow_stream_buffer(overflow_stream *s, size_t *capacity);
+int overflow_stream_commit(overflow_stream *s, size_t n);
+
+// Reads native-endian keys from fd until end of file. Reads may end
+// mid-key; a trailing partial key at end of file is an error. Returns 0,
+// or -1 on a read or allocation error.
+int overflow_stream_read_fd(overflow_stream *s, int fd);
+
+// Keys pushed since creation or the last finish.
+size_t overflow_stream_count(const overflow_stream *s);
+
+// Waits for the last chunk, then writes all keys in ascending order to
+// out, which must hold overflow_stream_count() keys; with out NULL the keys
+// are dropped. The stream is empty again afterwards. Returns 0, or -1 if
+// any earlier scatter failed.
+int overflow_stream_finish(overflow_stream *s, uint32_t *out);
+
+#endif
@@ -0,0 +1,45 @@
+/**
+ * @file overflow_tick.h
+ * @brief Overflow tick helpers shared by the library engines.
+ *
+ * A key's overflow tick is the number of doublings it takes to push its top
+ * set bit out of the word. The engines use the mirrored form, the bucket
+ * index `width - tick + 1`, which grows with magnitude so that an ascending
+ * counting pass over buckets yields ascending keys. Key 0 never overflows
+ * and lands in bucket 0.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#ifndef OVERFLOW_TICK_H
+#define OVERFLOW_TICK_H
+
+#include <stdint.h>
+
+#define OVERFLOW_TICKS_U32 33 // Buckets 0..32 for uint32_t keys
+#define OVERFLOW_TICKS_U64 65 // Buckets 0..64 for uint64_t keys
+
+static inline unsigned overflow_tick_u32(uint32_t v) {
+  return v ? 32 - (unsigned)__builtin_clz(v) : 0;
+}
+
+static inline unsigned overflow_tick_u64(uint64_t v) {
+  return v ? 64 - (unsigned)__builtin_clzll(v) : 0;
+}
+
+// Log-linear bins: every tick bucket above 2^(s+1) is split into 2^s equal
+// sub-buckets by the s bits below the leading bit, and smaller keys get a
+// bin each. Bins grow with the key; with s = 0 the bin is the tick.
+#define OVERFLOW_LOGLIN_SUB_MAX 10 // Keeps bin indices below 2^16
+#define OVERFLOW_LOGLIN_BINS_U32(s) ((33u - (s)) << (s))
+
+static inline unsigned overflow_loglin_u32(uint32_t v, unsigned s) {
+  if (v >> s <= 1)
+    return v;
+  unsigned t = overflow_tick_u32(v);
+  return ((t - s) << s) + ((v >> (t - 1 - s)) & ((1u << s) - 1));
+}
+
+#endif
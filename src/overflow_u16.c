@@ -0,0 +1,154 @@
+/**
+ * @file overflow_u16.c
+ * @brief Two-level counting sort for full-range uint16_t keys.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include "overflow_u16.h"
+#include "overflow_engine.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define BINS 256
+#define DENSE_MIN (4 * BINS * BINS) // Below this slice runs are too short
+
+static void insertion_sort_u16(uint16_t *keys, size_t n) {
+  for (size_t i = 1; i < n; ++i) {
+    uint16_t key = keys[i];
+    size_t j = i;
+    while (j > 0 && keys[j - 1] > key) {
+      keys[j] = keys[j - 1];
+      --j;
+    }
+    keys[j] = key;
+  }
+}
+
+// High- and low-byte histograms in one read, two sub-histograms each.
+static void byte_histograms(const uint16_t *keys, size_t n, size_t *hi,
+                            size_t *lo) {
+  size_t h[2][BINS] = {{0}};
+  size_t l[2][BINS] = {{0}};
+  size_t i = 0;
+
+  for (; i + 2 <= n; i += 2) {
+    h[0][keys[i] >> 8]++;
+    l[0][keys[i] & 0xff]++;
+    h[1][keys[i + 1] >> 8]++;
+    l[1][keys[i + 1] & 0xff]++;
+  }
+  if (i < n) {
+    h[0][keys[i] >> 8]++;
+    l[0][keys[i] & 0xff]++;
+  }
+  for (int b = 0; b < BINS; ++b) {
+    hi[b] = h[0][b] + h[1][b];
+    lo[b] = l[0][b] + l[1][b];
+  }
+}
+
+// Writes `count` copies of v, eight bytes per store.
+static uint16_t *fill_u16(uint16_t *dst, uint16_t v, size_t count) {
+  uint64_t pattern = v * 0x0001000100010001ull;
+  size_t i = 0;
+
+  for (; i + 4 <= count; i += 4)
+    memcpy(&dst[i], &pattern, sizeof(pattern));
+  for (; i < count; ++i)
+    dst[i] = v;
+  return dst + count;
+}
+
+static uint16_t *emit_slice(uint16_t *out, unsigned hi, const size_t *lo) {
+  for (unsigned b = 0; b < BINS; ++b)
+    if (lo[b])
+      out = fill_u16(out, (uint16_t)(hi << 8 | b), lo[b]);
+  return out;
+}
+
+// Two stable byte scatters driven by the histograms already counted.
+static void lsd_sort(uint16_t *keys, uint16_t *tmp, size_t n, size_t *lo,
+                     size_t *hi) {
+  size_t sum_lo = 0, sum_hi = 0;
+  for (int b = 0; b < BINS; ++b) {
+    size_t c = lo[b];
+    lo[b] = sum_lo;
+    sum_lo += c;
+    c = hi[b];
+    hi[b] = sum_hi;
+    sum_hi += c;
+  }
+  for (size_t i = 0; i < n; ++i)
+    tmp[lo[keys[i] & 0xff]++] = keys[i];
+  for (size_t i = 0; i < n; ++i)
+    keys[hi[tmp[i] >> 8]++] = tmp[i];
+}
+
+void overflow_count_sort_u16(uint16_t *keys, size_t n, uint16_t *scratch) {
+  size_t hi[BINS], lo[BINS];
+
+  if (n <= OVERFLOW_INSERTION_MAX) {
+    insertion_sort_u16(keys, n);
+    return;
+  }
+
+  byte_histograms(keys, n, hi, lo);
+
+  // One populated slice: the low-byte histogram already is the answer
+  int slices = 0, only = 0;
+  for (int b = 0; b < BINS; ++b)
+    if (hi[b]) {
+      slices++;
+      only = b;
+    }
+  if (slices == 1) {
+    emit_slice(keys, (unsigned)only, lo);
+    return;
+  }
+  if (n < DENSE_MIN) {
+    lsd_sort(keys, scratch, n, lo, hi);
+    return;
+  }
+
+  // First level: scatter low bytes into their high-byte slice
+  uint8_t *bytes = (uint8_t *)scratch;
+  size_t start[BINS + 1], cursor[BINS];
+  size_t sum = 0;
+  for (int b = 0; b < BINS; ++b) {
+    start[b] = cursor[b] = sum;
+    sum += hi[b];
+  }
+  start[BINS] = sum;
+  for (size_t i = 0; i < n; ++i)
+    bytes[cursor[keys[i] >> 8]++] = (uint8_t)keys[i];
+
+  // Second level: count each slice's low bytes and emit runs
+  uint16_t *out = keys;
+  for (unsigned h = 0; h < BINS; ++h) {
+    const uint8_t *slice = &bytes[start[h]];
+    if (!hi[h])
+      continue;
+    memset(lo, 0, sizeof(lo));
+    for (size_t i = 0; i < hi[h]; ++i)
+      lo[slice[i]]++;
+    out = emit_slice(out, h, lo);
+  }
+}
+
+int overflow_sort_u16(uint16_t *keys, size_t n) {
+  if (n <= OVERFLOW_INSERTION_MAX) {
+    overflow_count_sort_u16(keys, n, NULL);
+    return 0;
+  }
+
+  uint16_t *scratch = malloc(n * sizeof(uint16_t));
+  if (!scratch)
+    return -1;
+  overflow_count_sort_u16(keys, n, scratch);
+  free(scratch);
+  return 0;
+}
@@ -0,0 +1,32 @@
+/**
+ * @file overflow_u16.h
+ * @brief Two-level counting sort for full-range uint16_t keys.
+ *
+ * A direct 65536-bin counting sort needs a 256 KiB histogram, which misses
+ * L1 on every increment for full-range data. Instead the high byte splits
+ * the input into 256 slices, only the low bytes are scattered (one byte per
+ * key), and each slice is finished by a 256-bin counting sort whose output
+ * is written straight as runs of `hi << 8 | lo`. Both bytes are histogrammed
+ * in the first read; when every key shares one high byte, as with 8-bit
+ * sensor data widened to uint16_t, that read is all the sort needs.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#ifndef OVERFLOW_U16_H
+#define OVERFLOW_U16_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Sorts keys in place; scratch must hold n keys. Inputs under 256K keys
+// are too sparse per slice and take a two-pass LSD radix instead, reusing
+// the same first-read histograms.
+void overflow_count_sort_u16(uint16_t *keys, size_t n, uint16_t *scratch);
+
+// Allocating wrapper; returns 0 on success, -1 if scratch allocation fails.
+int overflow_sort_u16(uint16_t *keys, size_t n);
+
+#endif
@@ -0,0 +1,154 @@
+/**
+ * @file overflow_u8.c
+ * @brief Byte-key engine: 256-bin counting sort for uint8_t arrays.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include "overflow_u8.h"
+#include "overflow_parallel.h"
+#include "overflow_tick.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define SUB_HISTS 4
+
+void overflow_byte_histogram(const uint8_t *keys, size_t n, size_t *counts) {
+  // uint32_t sub-histograms keep all four in 4 KiB of L1; flush them before
+  // any counter could wrap
+  const size_t block = (size_t)UINT32_MAX / 8 * 8;
+  uint32_t sub[SUB_HISTS][OVERFLOW_U8_BINS];
+
+  memset(counts, 0, OVERFLOW_U8_BINS * sizeof(size_t));
+  while (n > 0) {
+    size_t len = n < block ? n : block;
+    size_t i = 0;
+
+    memset(sub, 0, sizeof(sub));
+    for (; i + 8 <= len; i += 8) {
+      uint64_t w;
+      memcpy(&w, &keys[i], sizeof(w));
+      sub[0][w & 0xff]++;
+      sub[1][(w >> 8) & 0xff]++;
+      sub[2][(w >> 16) & 0xff]++;
+      sub[3][(w >> 24) & 0xff]++;
+      sub[0][(w >> 32) & 0xff]++;
+      sub[1][(w >> 40) & 0xff]++;
+      sub[2][(w >> 48) & 0xff]++;
+      sub[3][w >> 56]++;
+    }
+    for (; i < len; ++i)
+      sub[0][keys[i]]++;
+
+    for (int b = 0; b < OVERFLOW_U8_BINS; ++b)
+      counts[b] += (size_t)sub[0][b] + sub[1][b] + sub[2][b] + sub[3][b];
+    keys += len;
+    n -= len;
+  }
+}
+
+// Output runs: value runs[r] repeated for the range [start[r], start[r+1]).
+typedef struct {
+  int runs;
+  uint8_t value[OVERFLOW_U8_BINS];
+  size_t start[OVERFLOW_U8_BINS + 1];
+} RunPlan;
+
+static void plan_runs(const size_t *counts, unsigned flags, RunPlan *plan) {
+  size_t classes[OVERFLOW_U8_TICKS] = {0};
+  unsigned bins = OVERFLOW_U8_BINS;
+  size_t sum = 0;
+
+  // Tick-only output folds the byte bins into magnitude classes
+  if (flags & OVERFLOW_U8_TICKS_ONLY) {
+    for (unsigned b = 0; b < OVERFLOW_U8_BINS; ++b)
+      classes[overflow_tick_u32(b)] += counts[b];
+    counts = classes;
+    bins = OVERFLOW_U8_TICKS;
+  }
+
+  plan->runs = 0;
+  for (unsigned b = 0; b < bins; ++b) {
+    if (counts[b] == 0)
+      continue;
+    plan->value[plan->runs] = (uint8_t)b;
+    plan->start[plan->runs++] = sum;
+    sum += counts[b];
+  }
+  plan->start[plan->runs] = sum;
+}
+
+// Writes the part of the planned output that falls in [lo, hi).
+static void fill_range(uint8_t *keys, const RunPlan *plan, size_t lo,
+                       size_t hi) {
+  int r = 0;
+  while (r < plan->runs && plan->start[r + 1] <= lo)
+    ++r;
+  for (; r < plan->runs && plan->start[r] < hi; ++r) {
+    size_t a = plan->start[r] > lo ? plan->start[r] : lo;
+    size_t b = plan->start[r + 1] < hi ? plan->start[r + 1] : hi;
+    memset(&keys[a], plan->value[r], b - a);
+  }
+}
+
+void overflow_sort_u8(uint8_t *keys, size_t n, unsigned flags) {
+  size_t counts[OVERFLOW_U8_BINS];
+  RunPlan plan;
+
+  overflow_byte_histogram(keys, n, counts);
+  plan_runs(counts, flags, &plan);
+  fill_range(keys, &plan, 0, n);
+}
+
+typedef struct {
+  uint8_t *keys;
+  size_t n;
+  unsigned threads;
+  size_t (*hist)[OVERFLOW_U8_BINS];
+  const RunPlan *plan; // NULL during the histogram phase
+} ByteJob;
+
+static void byte_worker(void *arg, unsigned id) {
+  ByteJob *job = arg;
+  size_t lo = job->n * id / job->threads;
+  size_t hi = job->n * (id + 1) / job->threads;
+
+  if (job->plan)
+    fill_range(job->keys, job->plan, lo, hi);
+  else
+    overflow_byte_histogram(&job->keys[lo], hi - lo, job->hist[id]);
+}
+
+void overflow_sort_u8_threads(uint8_t *keys, size_t n, unsigned threads,
+                              unsigned flags) {
+  if (threads == 0)
+    threads = overflow_parallel_threads();
+  if (threads > n / OVERFLOW_U8_PARALLEL_MIN)
+    threads = (unsigned)(n / OVERFLOW_U8_PARALLEL_MIN);
+  if (threads > OVERFLOW_MAX_THREADS)
+    threads = OVERFLOW_MAX_THREADS;
+
+  size_t (*hist)[OVERFLOW_U8_BINS] =
+      threads > 1 ? malloc(threads * sizeof(*hist)) : NULL;
+  if (!hist) {
+    overflow_sort_u8(keys, n, flags);
+    return;
+  }
+
+  ByteJob job = {.keys = keys, .n = n, .threads = threads, .hist = hist};
+  overflow_parallel_run(threads, byte_worker, &job);
+
+  size_t counts[OVERFLOW_U8_BINS] = {0};
+  for (unsigned w = 0; w < threads; ++w)
+    for (int b = 0; b < OVERFLOW_U8_BINS; ++b)
+      counts[b] += hist[w][b];
+  free(hist);
+
+  RunPlan plan;
+  plan_runs(counts, flags, &plan);
+  job.plan = &plan;
+  overflow_parallel_run(threads, byte_worker, &job);
+}
@@ -0,0 +1,40 @@
+/**
+ * @file overflow_u8.h
+ * @brief Byte-key engine: 256-bin counting sort for uint8_t arrays.
+ *
+ * Byte keys need no tick scatter at all; one histogram pass over the input
+ * and one run of memset()s over the output sort them. The histogram spreads
+ * consecutive bytes over independent sub-histograms so repeated values do
+ * not serialize on one counter.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#ifndef OVERFLOW_U8_H
+#define OVERFLOW_U8_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define OVERFLOW_U8_BINS 256
+#define OVERFLOW_U8_TICKS 9                 // Magnitude classes 0..8
+#define OVERFLOW_U8_PARALLEL_MIN (16u << 20) // Bytes per worker
+
+// Engine flags
+#define OVERFLOW_U8_TICKS_ONLY 0x1 // Emit sorted tick classes, not keys
+
+// Byte histogram of keys[0..n) into counts[OVERFLOW_U8_BINS].
+void overflow_byte_histogram(const uint8_t *keys, size_t n, size_t *counts);
+
+// Sorts keys in place. With OVERFLOW_U8_TICKS_ONLY each key is replaced by
+// its tick (bit width), so the output is the sorted magnitude classes.
+void overflow_sort_u8(uint8_t *keys, size_t n, unsigned flags);
+
+// Same with up to `threads` workers (0 = all online CPUs). Falls back to
+// fewer workers if threads or per-worker histograms cannot be allocated.
+void overflow_sort_u8_threads(uint8_t *keys, size_t n, unsigned threads,
+                              unsigned flags);
+
+#endif
@@ -0,0 +1,187 @@
+/**
+ * @file overflow_unique.c
+ * @brief Distinct uint32_t keys in order, with counts or payload sums.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include "overflow_unique.h"
+#include "overflow_columns.h"
+#include "overflow_engine.h"
+#include "overflow_tick.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define LANES 4        // Interleaved dense counter sets for small tables
+#define LANES_MAX 4096 // Largest table that is split across lanes
+
+// Keys [lo, hi) of a tick bucket
+static inline uint32_t tick_lo(unsigned t) { return t ? 1u << (t - 1) : 0; }
+static inline size_t tick_hi(unsigned t) { return (size_t)1 << t; }
+
+typedef struct {
+  size_t hist[OVERFLOW_TICKS_U32];
+  unsigned char dense[OVERFLOW_TICKS_U32]; // Bucket aggregated in place
+  uint64_t *tally, *tsum;                  // Dense counters and sums
+  size_t table;                            // Dense counters per lane
+  unsigned lanes;                          // Counter sets in tally
+  uint32_t *skeys, *spay, *perm;           // Spilled keys, payloads, order
+} Groups;
+
+// Aggregates dense buckets and sorts the spill. With payloads the spill is
+// ordered through a permutation so keys and payloads stay paired.
+static int aggregate(Groups *g, const uint32_t *keys, const uint32_t *payload,
+                     size_t n) {
+  // Only the populated dense ranges are cleared and later scanned
+  for (unsigned t = 0; t < OVERFLOW_TICKS_U32; ++t) {
+    if (!g->dense[t])
+      continue;
+    size_t lo = tick_lo(t), len = tick_hi(t) - lo;
+    for (unsigned l = 0; l < g->lanes; ++l)
+      memset(g->tally + l * g->table + lo, 0, len * sizeof(uint64_t));
+    if (g->tsum)
+      memset(g->tsum + lo, 0, len * sizeof(uint64_t));
+  }
+
+  size_t m = 0;
+  if (g->tsum) {
+    for (size_t i = 0; i < n; ++i) {
+      uint32_t k = keys[i];
+      if (g->dense[overflow_tick_u32(k)]) {
+        g->tally[k]++;
+        g->tsum[k] += payload[i];
+      } else {
+        g->skeys[m] = k;
+        g->spay[m++] = payload[i];
+      }
+    }
+    overflow_column col = {g->skeys, sizeof(uint32_t), 0};
+    return overflow_order_columns(&col, 1, m, g->perm);
+  }
+
+  if (g->table == 0) {
+    memcpy(g->skeys, keys, n * sizeof(uint32_t)); // Nothing dense
+    return overflow_sort_u32(g->skeys, n);
+  }
+
+  // Consecutive keys count into different lanes, so runs of one hot key
+  // don't serialize on a single counter
+  size_t i = 0;
+  if (g->lanes == LANES) {
+    for (; i + LANES <= n; i += LANES) {
+      for (unsigned l = 0; l < LANES; ++l) {
+        uint32_t k = keys[i + l];
+        if (g->dense[overflow_tick_u32(k)])
+          g->tally[l * g->table + k]++;
+        else
+          g->skeys[m++] = k;
+      }
+    }
+  }
+  for (; i < n; ++i) {
+    uint32_t k = keys[i];
+    if (g->dense[overflow_tick_u32(k)])
+      g->tally[k]++;
+    else
+      g->skeys[m++] = k;
+  }
+  for (unsigned t = 0; t < OVERFLOW_TICKS_U32; ++t)
+    for (unsigned l = 1; g->dense[t] && l < g->lanes; ++l)
+      for (size_t k = tick_lo(t); k < tick_hi(t); ++k)
+        g->tally[k] += g->tally[l * g->table + k];
+  return overflow_sort_u32(g->skeys, m);
+}
+
+// Emits one entry per distinct key, buckets in tick order; spilled buckets
+// are contiguous in the sorted spill.
+static size_t emit(const Groups *g, uint32_t *out, uint64_t *counts,
+                   uint64_t *sums) {
+  const uint32_t *perm = g->tsum ? g->perm : NULL;
+  size_t d = 0, j = 0;
+
+  for (unsigned t = 0; t < OVERFLOW_TICKS_U32; ++t) {
+    if (!g->hist[t])
+      continue;
+    if (g->dense[t]) {
+      for (size_t k = tick_lo(t); k < tick_hi(t); ++k) {
+        if (!g->tally[k])
+          continue;
+        out[d] = (uint32_t)k;
+        if (counts)
+          counts[d] = g->tally[k];
+        if (g->tsum)
+          sums[d] = g->tsum[k];
+        d++;
+      }
+      continue;
+    }
+    for (size_t end = j + g->hist[t]; j < end; ++d) {
+      uint32_t k = g->skeys[perm ? perm[j] : j];
+      uint64_t c = 0, s = 0;
+      for (; j < end && g->skeys[perm ? perm[j] : j] == k; ++j, ++c)
+        s += perm ? g->spay[perm[j]] : 0;
+      out[d] = k;
+      if (counts)
+        counts[d] = c;
+      if (g->tsum)
+        sums[d] = s;
+    }
+  }
+  return d;
+}
+
+int overflow_count_distinct_sorted(const uint32_t *keys,
+                                   const uint32_t *payload, size_t n,
+                                   uint32_t *out, uint64_t *counts,
+                                   uint64_t *sums, size_t *distinct) {
+  Groups g = {0};
+  size_t spilled = 0;
+  int summing = sums && payload;
+
+  *distinct = 0;
+  overflow_tick_histogram_u32(keys, n, g.hist);
+  for (unsigned t = 0; t < OVERFLOW_TICKS_U32; ++t) {
+    size_t range = tick_hi(t) - tick_lo(t);
+    g.dense[t] = g.hist[t] && t <= OVERFLOW_UNIQUE_DENSE_BITS &&
+                 range <= OVERFLOW_UNIQUE_DENSE_RATIO * g.hist[t];
+    if (g.dense[t])
+      g.table = tick_hi(t); // One counter per key below this
+    else
+      spilled += g.hist[t];
+  }
+  if (summing && spilled > UINT32_MAX)
+    return -1;
+
+  g.lanes = !summing && g.table <= LANES_MAX ? LANES : 1;
+
+  // One spare entry keeps every allocation non-empty
+  g.tally = malloc((g.lanes * g.table + 1) * sizeof(uint64_t));
+  g.skeys = malloc((spilled + 1) * sizeof(uint32_t));
+  if (summing) {
+    g.tsum = malloc((g.table + 1) * sizeof(uint64_t));
+    g.spay = malloc((spilled + 1) * sizeof(uint32_t));
+    g.perm = malloc((spilled + 1) * sizeof(uint32_t));
+  }
+
+  int rc = -1;
+  if (g.tally && g.skeys && (!summing || (g.tsum && g.spay && g.perm)) &&
+      aggregate(&g, keys, payload, n) == 0) {
+    *distinct = emit(&g, out, counts, sums);
+    rc = 0;
+  }
+  free(g.tally);
+  free(g.tsum);
+  free(g.skeys);
+  free(g.spay);
+  free(g.perm);
+  return rc;
+}
+
+int overflow_sort_unique(const uint32_t *keys, size_t n, uint32_t *out,
+                         size_t *distinct) {
+  return overflow_count_distinct_sorted(keys, NULL, n, out, NULL, NULL,
+                                        distinct);
+}
@@ -0,0 +1,42 @@
+/**
+ * @file overflow_unique.h
+ * @brief Distinct uint32_t keys in order, with counts or payload sums.
+ *
+ * The full sorted array is never written. A tick histogram of the input
+ * decides per bucket: a bucket whose key range is small next to its
+ * population (and lies below 2^16) is aggregated in place, one counter per
+ * possible key, in a single pass over the input. Only keys of the
+ * remaining buckets are copied out and sorted, then run-length merged.
+ * On low-cardinality data the whole job is one read of the input and a
+ * write of one entry per distinct key.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#ifndef OVERFLOW_UNIQUE_H
+#define OVERFLOW_UNIQUE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define OVERFLOW_UNIQUE_DENSE_BITS 16  // Dense counters cover keys < 2^16
+#define OVERFLOW_UNIQUE_DENSE_RATIO 16 // Dense if range <= ratio * keys
+
+// Writes the distinct keys of keys[0..n) in ascending order to out and
+// their number to *distinct. out must have room for n keys. Returns 0, or
+// -1 if scratch allocation fails.
+int overflow_sort_unique(const uint32_t *keys, size_t n, uint32_t *out,
+                         size_t *distinct);
+
+// As above, plus the occurrences of each distinct key in counts and, with
+// a payload, the sum of its payload values in sums. counts and sums may
+// be NULL; each needs room for n entries otherwise. Summing also fails if
+// more than UINT32_MAX keys fall outside the dense buckets.
+int overflow_count_distinct_sorted(const uint32_t *keys,
+                                   const uint32_t *payload, size_t n,
+                                   uint32_t *out, uint64_t *counts,
+                                   uint64_t *sums, size_t *distinct);
+
+#endif
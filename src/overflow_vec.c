@@ -0,0 +1,179 @@
+/**
+ * @file overflow_vec.c
+ * @brief Width-generic tick kernels with runtime backend selection.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include "overflow_vec.h"
+#include "overflow_tick.h"
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define VEC_HIST_BLOCK 1024 // Keys per tick block in the histogram kernels
+
+#if defined(__x86_64__) || defined(__i386__)
+#define VEC_X86 1
+#define TARGET_256 __attribute__((target("avx2")))
+#define TARGET_512 __attribute__((target("avx512f,avx512bw")))
+#else
+#define TARGET_256
+#define TARGET_512
+#endif
+
+// ----------------- Scalar reference -----------------
+static void scalar_ticks_u8(const uint8_t *keys, size_t n, uint8_t *ticks) {
+  for (size_t i = 0; i < n; ++i)
+    ticks[i] = (uint8_t)overflow_tick_u32(keys[i]);
+}
+
+static void scalar_ticks_u16(const uint16_t *keys, size_t n, uint8_t *ticks) {
+  for (size_t i = 0; i < n; ++i)
+    ticks[i] = (uint8_t)overflow_tick_u32(keys[i]);
+}
+
+static void scalar_ticks_u32(const uint32_t *keys, size_t n, uint8_t *ticks) {
+  for (size_t i = 0; i < n; ++i)
+    ticks[i] = (uint8_t)overflow_tick_u32(keys[i]);
+}
+
+static void scalar_histogram_u32(const uint32_t *keys, size_t n,
+                                 size_t *counts) {
+  memset(counts, 0, OVERFLOW_TICKS_U32 * sizeof(size_t));
+  for (size_t i = 0; i < n; ++i)
+    counts[overflow_tick_u32(keys[i])]++;
+}
+
+static void scalar_histogram_minmax_u32(const uint32_t *keys, size_t n,
+                                        size_t *counts, uint32_t *lo,
+                                        uint32_t *hi) {
+  uint32_t a = UINT32_MAX, b = 0;
+  memset(counts, 0, OVERFLOW_TICKS_U32 * sizeof(size_t));
+  for (size_t i = 0; i < n; ++i) {
+    counts[overflow_tick_u32(keys[i])]++;
+    a = keys[i] < a ? keys[i] : a;
+    b = keys[i] > b ? keys[i] : b;
+  }
+  *lo = a;
+  *hi = b;
+}
+
+static void scalar_loglin_u32(const uint32_t *keys, size_t n, unsigned s,
+                              uint16_t *bins) {
+  for (size_t i = 0; i < n; ++i)
+    bins[i] = (uint16_t)overflow_loglin_u32(keys[i], s);
+}
+
+static size_t scalar_count_below_u32(const uint32_t *keys, size_t n,
+                                     uint32_t v) {
+  size_t count = 0;
+  for (size_t i = 0; i < n; ++i)
+    count += keys[i] < v;
+  return count;
+}
+
+static uint32_t scalar_min_u32(const uint32_t *keys, size_t n) {
+  uint32_t m = UINT32_MAX;
+  for (size_t i = 0; i < n; ++i)
+    m = keys[i] < m ? keys[i] : m;
+  return m;
+}
+
+static void scalar_minmax_u32(const uint32_t *keys, size_t n, uint32_t *lo,
+                              uint32_t *hi) {
+  uint32_t a = UINT32_MAX, b = 0;
+  for (size_t i = 0; i < n; ++i) {
+    a = keys[i] < a ? keys[i] : a;
+    b = keys[i] > b ? keys[i] : b;
+  }
+  *lo = a;
+  *hi = b;
+}
+
+// ----------------- Vector instantiations -----------------
+#define VEC_BYTES 16
+#define VEC_FN(name) vec128_##name
+#define VEC_TARGET
+#include "overflow_vec_kernels.inc"
+#undef VEC_BYTES
+#undef VEC_FN
+#undef VEC_TARGET
+
+#define VEC_BYTES 32
+#define VEC_FN(name) vec256_##name
+#define VEC_TARGET TARGET_256
+#include "overflow_vec_kernels.inc"
+#undef VEC_BYTES
+#undef VEC_FN
+#undef VEC_TARGET
+
+#define VEC_BYTES 64
+#define VEC_FN(name) vec512_##name
+#define VEC_TARGET TARGET_512
+#include "overflow_vec_kernels.inc"
+#undef VEC_BYTES
+#undef VEC_FN
+#undef VEC_TARGET
+
+static const overflow_vec_ops backends[OVERFLOW_VEC_BACKENDS] = {
+    {"scalar", 0, scalar_ticks_u8, scalar_ticks_u16, scalar_ticks_u32,
+     scalar_histogram_u32, scalar_histogram_minmax_u32, scalar_loglin_u32,
+     scalar_count_below_u32, scalar_min_u32, scalar_minmax_u32},
+    {"vec128", 16, vec128_ticks_u8, vec128_ticks_u16, vec128_ticks_u32,
+     vec128_histogram_u32, vec128_histogram_minmax_u32, vec128_loglin_u32,
+     vec128_count_below_u32, vec128_min_u32, vec128_minmax_u32},
+    {"vec256", 32, vec256_ticks_u8, vec256_ticks_u16, vec256_ticks_u32,
+     vec256_histogram_u32, vec256_histogram_minmax_u32, vec256_loglin_u32,
+     vec256_count_below_u32, vec256_min_u32, vec256_minmax_u32},
+    {"vec512", 64, vec512_ticks_u8, vec512_ticks_u16, vec512_ticks_u32,
+     vec512_histogram_u32, vec512_histogram_minmax_u32, vec512_loglin_u32,
+     vec512_count_below_u32, vec512_min_u32, vec512_minmax_u32},
+};
+
+static int supported(int which) {
+#ifdef VEC_X86
+  __builtin_cpu_init();
+  if (which == OVERFLOW_VEC_256)
+    return __builtin_cpu_supports("avx2");
+  if (which == OVERFLOW_VEC_512)
+    return __builtin_cpu_supports("avx512f") &&
+           __builtin_cpu_supports("avx512bw");
+#endif
+  // Without target attributes the compiler lowers every width to whatever
+  // the baseline ISA offers, so all of them run
+  return which >= 0 && which < OVERFLOW_VEC_BACKENDS;
+}
+
+const overflow_vec_ops *overflow_vec_backend(int which) {
+  return supported(which) ? &backends[which] : NULL;
+}
+
+const overflow_vec_ops *overflow_vec_best(void) {
+  static _Atomic(const overflow_vec_ops *) best;
+  const overflow_vec_ops *ops = atomic_load(&best);
+
+  if (ops)
+    return ops;
+
+  int limit = OVERFLOW_VEC_BACKENDS - 1;
+  const char *env = getenv("OVERFLOW_VEC");
+  if (env) {
+    for (int i = 0; i < OVERFLOW_VEC_BACKENDS; ++i)
+      if (strcmp(env, backends[i].name) == 0 ||
+          (backends[i].bytes && atoi(env) == (int)backends[i].bytes * 8))
+        limit = i;
+  }
+
+  for (int i = limit; i >= 0; --i) {
+    if (supported(i)) {
+      ops = &backends[i];
+      break;
+    }
+  }
+  atomic_store(&best, ops);
+  return ops;
+}
@@ -0,0 +1,68 @@
+/**
+ * @file overflow_vec.h
+ * @brief Width-generic tick kernels with runtime backend selection.
+ *
+ * The kernels are written once against GCC/Clang vector extensions (see
+ * overflow_vec_kernels.inc) and instantiated for 128-, 256- and 512-bit
+ * vectors, plus a scalar reference. overflow_vec_best() picks the widest
+ * backend the CPU supports; tests compare every backend with the scalar one.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#ifndef OVERFLOW_VEC_H
+#define OVERFLOW_VEC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+enum {
+  OVERFLOW_VEC_SCALAR = 0,
+  OVERFLOW_VEC_128 = 1,
+  OVERFLOW_VEC_256 = 2,
+  OVERFLOW_VEC_512 = 3,
+  OVERFLOW_VEC_BACKENDS = 4
+};
+
+typedef struct {
+  const char *name;
+  unsigned bytes; // Vector width, 0 for the scalar reference
+
+  // ticks[i] = overflow bucket of keys[i] (see overflow_tick.h)
+  void (*ticks_u8)(const uint8_t *keys, size_t n, uint8_t *ticks);
+  void (*ticks_u16)(const uint16_t *keys, size_t n, uint8_t *ticks);
+  void (*ticks_u32)(const uint32_t *keys, size_t n, uint8_t *ticks);
+
+  // counts[OVERFLOW_TICKS_U32] = tick histogram of keys[0..n)
+  void (*histogram_u32)(const uint32_t *keys, size_t n, size_t *counts);
+
+  // The same histogram, with the smallest and largest key taken in the
+  // same pass
+  void (*histogram_minmax_u32)(const uint32_t *keys, size_t n, size_t *counts,
+                               uint32_t *lo, uint32_t *hi);
+
+  // bins[i] = overflow_loglin_u32(keys[i], sub_bits), for sub_bits up to
+  // OVERFLOW_LOGLIN_SUB_MAX
+  void (*loglin_u32)(const uint32_t *keys, size_t n, unsigned sub_bits,
+                     uint16_t *bins);
+
+  // Number of keys[0..n) below v
+  size_t (*count_below_u32)(const uint32_t *keys, size_t n, uint32_t v);
+
+  // Smallest of keys[0..n), UINT32_MAX if n is 0
+  uint32_t (*min_u32)(const uint32_t *keys, size_t n);
+
+  // Smallest and largest of keys[0..n); UINT32_MAX and 0 if n is 0
+  void (*minmax_u32)(const uint32_t *keys, size_t n, uint32_t *lo,
+                     uint32_t *hi);
+} overflow_vec_ops;
+
+// Backend by id, or NULL if this CPU can't run it.
+const overflow_vec_ops *overflow_vec_backend(int which);
+
+// Widest supported backend; $OVERFLOW_VEC (scalar/128/256/512) narrows it.
+const overflow_vec_ops *overflow_vec_best(void);
+
+#endif
@@ -0,0 +1,162 @@
+/**
+ * @file overflow_window.c
+ * @brief Windowed sorting of a continuous uint32_t key stream.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include "overflow_window.h"
+#include "overflow_stream.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+
+struct overflow_window {
+  overflow_window_emit emit;
+  void *arg;
+  overflow_stream *slot[2];
+  unsigned open;    // Slot filling on the caller
+  uint64_t next_id; // Number of the open window
+  uint32_t *out;    // Sorted output, reused across windows
+  size_t out_cap;
+  int push_failed;  // Set by the caller
+  int failed;       // Set by the sorter, under the lock when threaded
+
+  // Handoff to the sorter: at most one window is sealed
+  pthread_t sorter;
+  int threaded;
+  pthread_mutex_t lock;
+  pthread_cond_t cond;
+  int sealed; // Slot index, or -1
+  uint64_t sealed_id;
+  int stop;
+};
+
+// Sorts one sealed window into the output buffer and emits it. Returns -1,
+// dropping the window, if the buffer can't grow or a scatter failed.
+static int sort_window(overflow_window *w, unsigned slot, uint64_t id) {
+  overflow_stream *s = w->slot[slot];
+  size_t n = overflow_stream_count(s);
+
+  if (n > w->out_cap) {
+    size_t cap = w->out_cap ? w->out_cap : 1024;
+    while (cap < n)
+      cap *= 2;
+    uint32_t *out = realloc(w->out, cap * sizeof(uint32_t));
+    if (!out) {
+      overflow_stream_finish(s, NULL);
+      return -1;
+    }
+    w->out = out;
+    w->out_cap = cap;
+  }
+  if (overflow_stream_finish(s, w->out) != 0)
+    return -1;
+  w->emit(w->arg, id, w->out, n);
+  return 0;
+}
+
+static void *window_sorter(void *arg) {
+  overflow_window *w = arg;
+
+  pthread_mutex_lock(&w->lock);
+  for (;;) {
+    while (w->sealed < 0 && !w->stop)
+      pthread_cond_wait(&w->cond, &w->lock);
+    if (w->sealed < 0)
+      break;
+    unsigned slot = (unsigned)w->sealed;
+    uint64_t id = w->sealed_id;
+    pthread_mutex_unlock(&w->lock);
+
+    int rc = sort_window(w, slot, id);
+
+    pthread_mutex_lock(&w->lock);
+    w->failed |= rc != 0;
+    w->sealed = -1;
+    pthread_cond_broadcast(&w->cond);
+  }
+  pthread_mutex_unlock(&w->lock);
+  return NULL;
+}
+
+overflow_window *overflow_window_create(overflow_window_emit emit, void *arg,
+                                        size_t chunk) {
+  overflow_window *w = calloc(1, sizeof(*w));
+  if (!w)
+    return NULL;
+
+  chunk = chunk ? chunk : OVERFLOW_WINDOW_CHUNK;
+  w->slot[0] = overflow_stream_create(chunk);
+  w->slot[1] = overflow_stream_create(chunk);
+  if (!w->slot[0] || !w->slot[1]) {
+    overflow_stream_destroy(w->slot[0]);
+    overflow_stream_destroy(w->slot[1]);
+    free(w);
+    return NULL;
+  }
+
+  w->emit = emit;
+  w->arg = arg;
+  w->sealed = -1;
+  pthread_mutex_init(&w->lock, NULL);
+  pthread_cond_init(&w->cond, NULL);
+  w->threaded = pthread_create(&w->sorter, NULL, window_sorter, w) == 0;
+  return w;
+}
+
+int overflow_window_push(overflow_window *w, const uint32_t *keys, size_t n) {
+  if (overflow_stream_push(w->slot[w->open], keys, n) != 0)
+    w->push_failed = 1;
+  return w->push_failed ? -1 : 0;
+}
+
+int overflow_window_flush(overflow_window *w) {
+  if (w->threaded) {
+    pthread_mutex_lock(&w->lock);
+    while (w->sealed >= 0)
+      pthread_cond_wait(&w->cond, &w->lock);
+    pthread_mutex_unlock(&w->lock);
+  }
+  return w->failed || w->push_failed ? -1 : 0;
+}
+
+int overflow_window_close(overflow_window *w) {
+  uint64_t id = w->next_id++;
+  unsigned slot = w->open;
+
+  if (!w->threaded) {
+    w->failed |= sort_window(w, slot, id) != 0;
+    return w->failed || w->push_failed ? -1 : 0;
+  }
+
+  // The other slot is free again once the previous window is emitted
+  int rc = overflow_window_flush(w);
+  pthread_mutex_lock(&w->lock);
+  w->sealed = (int)slot;
+  w->sealed_id = id;
+  pthread_cond_broadcast(&w->cond);
+  pthread_mutex_unlock(&w->lock);
+  w->open ^= 1;
+  return rc;
+}
+
+void overflow_window_destroy(overflow_window *w) {
+  if (!w)
+    return;
+  if (w->threaded) {
+    pthread_mutex_lock(&w->lock);
+    w->stop = 1;
+    pthread_cond_broadcast(&w->cond);
+    pthread_mutex_unlock(&w->lock);
+    pthread_join(w->sorter, NULL); // Finishes a sealed window first
+  }
+  pthread_cond_destroy(&w->cond);
+  pthread_mutex_destroy(&w->lock);
+  overflow_stream_destroy(w->slot[0]);
+  overflow_stream_destroy(w->slot[1]);
+  free(w->out);
+  free(w);
+}
@@ -0,0 +1,57 @@
+/**
+ * @file overflow_window.h
+ * @brief Windowed sorting of a continuous uint32_t key stream.
+ *
+ * Keys are pushed into the open window; closing it hands the window to a
+ * sorter thread, which emits it in ascending order through a callback
+ * while the next window is already filling. Each window is an
+ * overflow_stream, so its keys are scattered into tick buckets as they
+ * arrive and only the bucket refinement runs after the close. Two streams
+ * alternate, and they, their tick segments and the output buffer are kept
+ * from one window to the next: in steady state no window allocates.
+ *
+ * At most one window is being sorted while the next fills. Closing a
+ * window while the previous one is still being sorted waits for it, which
+ * bounds memory and latency instead of queueing.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#ifndef OVERFLOW_WINDOW_H
+#define OVERFLOW_WINDOW_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define OVERFLOW_WINDOW_CHUNK (64u << 10) // Default keys per scatter chunk
+
+// Receives window `window` (numbered from 0) sorted. Runs on the sorter
+// thread; keys are only valid until it returns.
+typedef void (*overflow_window_emit)(void *arg, uint64_t window,
+                                     const uint32_t *keys, size_t n);
+
+typedef struct overflow_window overflow_window;
+
+// Creates a windowed sorter whose windows scatter every `chunk` keys
+// (0 = the default). Windows are sorted on the caller if the sorter
+// thread can't be started. Returns NULL if allocation fails.
+overflow_window *overflow_window_create(overflow_window_emit emit, void *arg,
+                                        size_t chunk);
+
+// Appends n keys to the open window. Returns 0, or -1 after any failure.
+int overflow_window_push(overflow_window *w, const uint32_t *keys, size_t n);
+
+// Seals the open window for sorting and opens the next one, first waiting
+// for the previous window to be emitted. Returns 0, or -1 after any
+// failure.
+int overflow_window_close(overflow_window *w);
+
+// Waits until every closed window has been emitted.
+int overflow_window_flush(overflow_window *w);
+
+// Flushes closed windows and frees the sorter; an open window is dropped.
+void overflow_window_destroy(overflow_window *w);
+
+#endif
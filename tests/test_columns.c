@@ -0,0 +1,127 @@
+/**
+ * @file test_columns.c
+ * @brief Checks the multi-column sort against qsort on whole rows.
+ *
+ * Tables mix widths, signed, float and descending columns, with low
+ * cardinality leading columns so later columns decide most ties, plus a
+ * constant column and a row index payload that pins down stability. Odd
+ * payload widths (3 and 12 bytes) are permuted byte-wise.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "overflow_columns.h"
+
+typedef struct {
+  uint8_t region;  // Ascending
+  int16_t delta;   // Signed, descending
+  uint32_t level;  // Constant
+  float score;     // Float
+  int64_t balance; // Signed
+  uint32_t row;
+} Row;
+
+#define CMP(a, b) ((a) < (b) ? -1 : (a) > (b) ? 1 : 0)
+
+int cmp_row(const void *pa, const void *pb) {
+  const Row *a = pa, *b = pb;
+  int c;
+  if ((c = CMP(a->region, b->region)))
+    return c;
+  if ((c = CMP(b->delta, a->delta)))
+    return c;
+  if ((c = CMP(a->level, b->level)))
+    return c;
+  if ((c = CMP(a->score, b->score)))
+    return c;
+  if ((c = CMP(a->balance, b->balance)))
+    return c;
+  return CMP(a->row, b->row);
+}
+
+int main() {
+  size_t sizes[] = {0, 1, 2, 17, 1000, 100003};
+  int failures = 0;
+
+  srand(36);
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+    size_t n = sizes[s];
+    Row *rows = malloc(sizeof(Row) * (n + 1));
+    uint8_t *region = malloc(n + 1);
+    int16_t *delta = malloc(sizeof(int16_t) * (n + 1));
+    uint32_t *level = malloc(sizeof(uint32_t) * (n + 1));
+    float *score = malloc(sizeof(float) * (n + 1));
+    int64_t *balance = malloc(sizeof(int64_t) * (n + 1));
+    uint32_t *row = malloc(sizeof(uint32_t) * (n + 1));
+    uint8_t *row3 = malloc(3 * (n + 1));
+    uint32_t *row12 = malloc(12 * (n + 1));
+
+    for (size_t i = 0; i < n; ++i) {
+      rows[i].region = region[i] = rand() % 4;
+      rows[i].delta = delta[i] = (int16_t)(rand() % 7 - 3);
+      rows[i].level = level[i] = 7;
+      rows[i].score = score[i] = (float)(rand() % 9 - 4) * 0.25f;
+      rows[i].balance = balance[i] =
+          ((int64_t)rand() << 32 | (uint32_t)rand()) * (rand() & 1 ? 1 : -1);
+      rows[i].row = row[i] = (uint32_t)i;
+      memcpy(&row3[i * 3], &row[i], 3);
+      row12[i * 3] = row12[i * 3 + 2] = (uint32_t)i;
+      row12[i * 3 + 1] = ~(uint32_t)i;
+    }
+    qsort(rows, n, sizeof(Row), cmp_row);
+
+    overflow_column keys[] = {
+        {region, 1, 0},
+        {delta, 2, OVERFLOW_COL_SIGNED | OVERFLOW_COL_DESCENDING},
+        {level, 4, 0},
+        {score, 4, OVERFLOW_COL_FLOAT},
+        {balance, 8, OVERFLOW_COL_SIGNED},
+    };
+    overflow_column payload[] = {{row, 4, 0}, {row3, 3, 0}, {row12, 12, 0}};
+
+    int ok = overflow_sort_columns(keys, 5, payload, 3, n) == 0;
+    for (size_t i = 0; ok && i < n; ++i) {
+      uint32_t r3 = 0;
+      memcpy(&r3, &row3[i * 3], 3);
+      ok = region[i] == rows[i].region && delta[i] == rows[i].delta &&
+           level[i] == rows[i].level && score[i] == rows[i].score &&
+           balance[i] == rows[i].balance && row[i] == rows[i].row &&
+           r3 == (row[i] & 0xffffff) && row12[i * 3] == row[i] &&
+           row12[i * 3 + 1] == ~row[i] && row12[i * 3 + 2] == row[i];
+    }
+    if (!ok) {
+      printf("FAIL: overflow_sort_columns n=%zu\n", n);
+      failures++;
+    }
+
+    free(rows);
+    free(region);
+    free(delta);
+    free(level);
+    free(score);
+    free(balance);
+    free(row);
+    free(row3);
+    free(row12);
+  }
+
+  // A key column of unsupported width is rejected before anything moves
+  uint8_t bytes[6] = {5, 4, 3, 2, 1, 0};
+  overflow_column mixed[] = {{bytes, 1, 0}, {bytes, 3, 0}};
+  if (overflow_sort_columns(&mixed[1], 1, NULL, 0, 2) != -1 ||
+      overflow_sort_columns(mixed, 2, NULL, 0, 2) != -1 || bytes[0] != 5) {
+    printf("FAIL: accepted a 3-byte key column\n");
+    failures++;
+  }
+
+  if (!failures)
+    printf("test_columns: OK\n");
+  return failures ? 1 : 0;
+}
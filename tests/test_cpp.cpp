@@ -0,0 +1,193 @@
+/**
+ * @file test_cpp.cpp
+ * @brief Checks the header-only overflow::sort() against std::stable_sort.
+ *
+ * Every key width, signed and floating-point keys, both orders, stable
+ * record sorts by projection and the parallel policy.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "overflow.hpp"
+
+static int failures = 0;
+
+template <class K>
+std::vector<K> make_keys(std::size_t n, std::mt19937_64 &rng) {
+  std::vector<K> v(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    std::uint64_t r = rng();
+    if constexpr (std::is_floating_point_v<K>) {
+      static const K edge[] = {K(0), -K(0), K(1), K(-1),
+                               std::numeric_limits<K>::infinity(),
+                               -std::numeric_limits<K>::infinity(),
+                               std::numeric_limits<K>::min(),
+                               std::numeric_limits<K>::max()};
+      v[i] = i % 5 == 0 ? edge[r % 8]
+                        : K(std::ldexp(double(std::int64_t(r)), -int(r % 70)));
+    } else {
+      // Full range, small magnitudes and duplicates
+      K full = K(r);
+      v[i] = i % 3 == 0 ? full : i % 3 == 1 ? K(r % 100) : K(full >> (r % 8));
+    }
+  }
+  return v;
+}
+
+// Bitwise equality, so -0.0 and 0.0 count as different keys. memcmp()
+// must not see the null data() of an empty vector.
+template <class K>
+bool same_bits(const std::vector<K> &a, const std::vector<K> &b) {
+  return a.size() == b.size() &&
+         (a.empty() ||
+          std::memcmp(a.data(), b.data(), a.size() * sizeof(K)) == 0);
+}
+
+template <unsigned Flags, class K>
+void check_keys(const char *name, std::size_t n, std::mt19937_64 &rng) {
+  auto keys = make_keys<K>(n, rng);
+  auto expect = keys;
+  auto bits = [](K k) {
+    return overflow::key_traits<K>::template encode<Flags>(k);
+  };
+  std::stable_sort(expect.begin(), expect.end(),
+                   [&](K a, K b) { return bits(a) < bits(b); });
+
+  auto seq = keys;
+  overflow::sort<Flags>(seq);
+  auto par = keys;
+  overflow::sort<Flags>(overflow::parallel_policy{4}, par.begin(), par.end());
+
+  if (!same_bits(seq, expect) || !same_bits(par, expect)) {
+    std::printf("FAIL: %s n=%zu flags=%u\n", name, n, Flags);
+    failures++;
+  }
+}
+
+template <class K> void check_type(const char *name, std::mt19937_64 &rng) {
+  for (std::size_t n : {0, 1, 2, 7, 16, 17, 48, 49, 1000, 300000}) {
+    check_keys<overflow::ascending, K>(name, n, rng);
+    check_keys<overflow::descending, K>(name, n, rng);
+  }
+}
+
+// Keys packed in [base, base + spread), which the sort rebases onto their
+// minimum; no_rebase must give the same order.
+template <unsigned Flags, class K>
+void check_band(const char *name, K base, std::uint64_t spread,
+                std::mt19937_64 &rng) {
+  for (std::size_t n : {17, 49, 1000, 300000}) {
+    std::vector<K> keys(n);
+    for (auto &k : keys)
+      k = K(base + K(rng() % spread));
+    auto expect = keys;
+    auto bits = [](K k) {
+      return overflow::key_traits<K>::template encode<Flags>(k);
+    };
+    std::stable_sort(expect.begin(), expect.end(),
+                     [&](K a, K b) { return bits(a) < bits(b); });
+
+    auto seq = keys;
+    overflow::sort<Flags>(seq);
+    auto raw = keys;
+    overflow::sort<Flags | overflow::no_rebase>(raw);
+    auto par = keys;
+    overflow::sort<Flags>(overflow::parallel_policy{4}, par);
+
+    if (!same_bits(seq, expect) || !same_bits(raw, expect) ||
+        !same_bits(par, expect)) {
+      std::printf("FAIL: %s band n=%zu flags=%u\n", name, n, Flags);
+      failures++;
+    }
+  }
+}
+
+struct Row {
+  std::int32_t key;
+  std::uint32_t seq;
+};
+
+static void check_records(std::mt19937_64 &rng) {
+  for (std::size_t n : {5, 40, 5000, 400000}) {
+    std::vector<Row> rows(n);
+    for (std::size_t i = 0; i < n; ++i)
+      rows[i] = {std::int32_t(rng() % 2001) - 1000, std::uint32_t(i)};
+
+    auto expect = rows;
+    std::stable_sort(expect.begin(), expect.end(),
+                     [](const Row &a, const Row &b) { return a.key > b.key; });
+
+    auto seq = rows;
+    overflow::sort<overflow::descending>(seq, &Row::key);
+    auto par = rows;
+    overflow::sort<overflow::descending>(overflow::parallel_policy{3}, par,
+                                         [](const Row &r) { return r.key; });
+
+    for (std::size_t i = 0; i < n; ++i) {
+      if (seq[i].seq != expect[i].seq || par[i].seq != expect[i].seq) {
+        std::printf("FAIL: stable record sort n=%zu at %zu\n", n, i);
+        failures++;
+        break;
+      }
+    }
+
+    // Unstable sorts must still order keys
+    auto loose = rows;
+    overflow::sort<overflow::unstable>(loose, &Row::key);
+    auto by_key = [](const Row &a, const Row &b) { return a.key < b.key; };
+    if (!std::is_sorted(loose.begin(), loose.end(), by_key)) {
+      std::printf("FAIL: unstable record sort n=%zu\n", n);
+      failures++;
+    }
+  }
+}
+
+int main() {
+  std::mt19937_64 rng(2024);
+
+  check_type<std::uint8_t>("uint8_t", rng);
+  check_type<std::int8_t>("int8_t", rng);
+  check_type<std::uint16_t>("uint16_t", rng);
+  check_type<std::int16_t>("int16_t", rng);
+  check_type<std::uint32_t>("uint32_t", rng);
+  check_type<std::int32_t>("int32_t", rng);
+  check_type<std::uint64_t>("uint64_t", rng);
+  check_type<std::int64_t>("int64_t", rng);
+  check_type<float>("float", rng);
+  check_type<double>("double", rng);
+  check_records(rng);
+
+  // Timestamp-like, narrow-band, negative-band and all-equal keys
+  check_band<overflow::ascending, std::uint64_t>(
+      "uint64_t", 1'700'000'000'000'000ull, 86'400'000'000ull, rng);
+  check_band<overflow::descending, std::uint64_t>("uint64_t", 1ull << 40,
+                                                  1u << 20, rng);
+  check_band<overflow::ascending, std::uint32_t>("uint32_t", 0x80000000u,
+                                                 1u << 16, rng);
+  check_band<overflow::ascending, std::int32_t>("int32_t", -5'000'000, 300,
+                                                rng);
+  check_band<overflow::descending, std::int64_t>("int64_t", -(1ll << 50),
+                                                 1u << 24, rng);
+  check_band<overflow::ascending, std::uint16_t>("uint16_t", 60000, 100, rng);
+  check_band<overflow::ascending, std::uint32_t>("uint32_t", 123456789u, 1,
+                                                 rng);
+
+  static_assert(overflow::key_traits<std::uint16_t>::ticks == 17);
+  static_assert(overflow::key_traits<std::uint64_t>::lanes == 4);
+
+  if (!failures)
+    std::printf("test_cpp: OK\n");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,169 @@
+/**
+ * @file test_ctx.c
+ * @brief Checks overflow_sort_ctx reuse and per-thread concurrency.
+ *
+ * Two threads sort with their own contexts at the same time. After the first
+ * call at the largest size, no further arena allocations may happen. A
+ * large-page context must produce the same output as the default one.
+ * Keys packed in a narrow band far from zero, which the engine rebases onto
+ * their minimum, must sort correctly on one thread and on several.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "overflow_ctx.h"
+
+#define SIZE 200000
+#define RUNS 20
+#define LARGE_SIZE (3 * OVERFLOW_CTX_PARALLEL_MIN + 17)
+
+typedef struct {
+  unsigned seed;
+  int failed;
+  size_t allocations;
+  size_t footprint;
+} Job;
+
+int cmp_uint32(const void *a, const void *b) {
+  uint32_t ua = *(const uint32_t *)a;
+  uint32_t ub = *(const uint32_t *)b;
+  return (ua > ub) - (ua < ub);
+}
+
+static void *sort_thread(void *arg) {
+  Job *job = arg;
+  uint32_t *keys = malloc(sizeof(uint32_t) * SIZE);
+  uint32_t *expect = malloc(sizeof(uint32_t) * SIZE);
+  overflow_sort_ctx ctx;
+
+  overflow_ctx_init(&ctx);
+  overflow_ctx_reserve(&ctx, SIZE);
+  size_t warm = ctx.allocations;
+
+  for (int run = 0; run < RUNS && !job->failed; ++run) {
+    // Shrinking and regrowing sizes must not reallocate after reserve
+    size_t n = SIZE - (size_t)(rand_r(&job->seed) % (SIZE / 2));
+    for (size_t i = 0; i < n; ++i)
+      keys[i] = (uint32_t)rand_r(&job->seed) >> (rand_r(&job->seed) % 24);
+    memcpy(expect, keys, sizeof(uint32_t) * n);
+    qsort(expect, n, sizeof(uint32_t), cmp_uint32);
+
+    if (overflow_sort_ctx_u32(&ctx, keys, n) != 0 ||
+        memcmp(keys, expect, sizeof(uint32_t) * n) != 0)
+      job->failed = 1;
+  }
+
+  job->allocations = ctx.allocations - warm;
+  job->footprint = overflow_ctx_footprint(&ctx);
+  overflow_ctx_free(&ctx);
+  free(keys);
+  free(expect);
+  return NULL;
+}
+
+static int check_large_pages(void) {
+  uint32_t *keys = malloc(sizeof(uint32_t) * LARGE_SIZE);
+  uint32_t *expect = malloc(sizeof(uint32_t) * LARGE_SIZE);
+  overflow_sort_ctx ctx;
+  int failed = 0;
+
+  srand(7);
+  for (size_t i = 0; i < LARGE_SIZE; ++i)
+    keys[i] = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+  memcpy(expect, keys, sizeof(uint32_t) * LARGE_SIZE);
+  qsort(expect, LARGE_SIZE, sizeof(uint32_t), cmp_uint32);
+
+  overflow_ctx_init(&ctx);
+  ctx.pages = OVERFLOW_PAGES_HUGE;
+  ctx.threads = 3;
+  if (overflow_sort_ctx_u32(&ctx, keys, LARGE_SIZE) != 0 ||
+      memcmp(keys, expect, sizeof(uint32_t) * LARGE_SIZE) != 0)
+    failed = 1;
+  if (ctx.arenas[OVERFLOW_ARENA_SCRATCH].mapped % OVERFLOW_HUGE_PAGE != 0 ||
+      ctx.arenas[OVERFLOW_ARENA_SCRATCH].mapped == 0)
+    failed = 1;
+
+  overflow_ctx_free(&ctx);
+  free(keys);
+  free(expect);
+  return failed;
+}
+
+static int check_narrow_band(void) {
+  static const uint32_t bases[] = {0x80000000u, 0xfff00000u, 123456789u};
+  static const uint32_t spreads[] = {100000, 1u << 20, 1};
+  uint32_t *keys = malloc(sizeof(uint32_t) * LARGE_SIZE);
+  uint32_t *expect = malloc(sizeof(uint32_t) * LARGE_SIZE);
+  int failed = 0;
+
+  srand(41);
+  for (int b = 0; b < 3; ++b) {
+    for (unsigned threads = 1; threads <= 3; threads += 2) {
+      overflow_sort_ctx ctx;
+      for (size_t i = 0; i < LARGE_SIZE; ++i)
+        keys[i] = bases[b] + (uint32_t)rand() % spreads[b];
+      memcpy(expect, keys, sizeof(uint32_t) * LARGE_SIZE);
+      qsort(expect, LARGE_SIZE, sizeof(uint32_t), cmp_uint32);
+
+      overflow_ctx_init(&ctx);
+      ctx.threads = threads;
+      if (overflow_sort_ctx_u32(&ctx, keys, LARGE_SIZE) != 0 ||
+          memcmp(keys, expect, sizeof(uint32_t) * LARGE_SIZE) != 0)
+        failed = 1;
+      overflow_ctx_free(&ctx);
+    }
+  }
+  free(keys);
+  free(expect);
+  return failed;
+}
+
+int main() {
+  Job jobs[2] = {{1, 0, 0, 0}, {2, 0, 0, 0}};
+  pthread_t tids[2];
+  int failures = 0;
+
+  for (int i = 0; i < 2; ++i)
+    pthread_create(&tids[i], NULL, sort_thread, &jobs[i]);
+  for (int i = 0; i < 2; ++i)
+    pthread_join(tids[i], NULL);
+
+  for (int i = 0; i < 2; ++i) {
+    if (jobs[i].failed) {
+      printf("FAIL: thread %d produced unsorted output\n", i);
+      failures++;
+    }
+    if (jobs[i].allocations != 0) {
+      printf("FAIL: thread %d made %zu steady-state allocations\n", i,
+             jobs[i].allocations);
+      failures++;
+    }
+    if (jobs[i].footprint < SIZE * sizeof(uint32_t)) {
+      printf("FAIL: thread %d footprint %zu too small\n", i,
+             jobs[i].footprint);
+      failures++;
+    }
+  }
+
+  if (check_large_pages()) {
+    printf("FAIL: large-page context\n");
+    failures++;
+  }
+
+  if (check_narrow_band()) {
+    printf("FAIL: narrow-band keys\n");
+    failures++;
+  }
+
+  if (!failures)
+    printf("test_ctx: OK\n");
+  return failures ? 1 : 0;
+}
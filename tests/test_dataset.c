@@ -0,0 +1,131 @@
+/**
+ * @file test_dataset.c
+ * @brief Checks dataset determinism, distribution shape and the mmap cache.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "overflow_dataset.h"
+
+#define N 300001 // Not a multiple of the block or vector size
+
+static int failures = 0;
+
+static void check(int ok, const char *what) {
+  if (!ok) {
+    printf("FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+int main() {
+  overflow_dataset_spec specs[] = {
+      {.dist = OVERFLOW_DIST_UNIFORM, .seed = 1, .range = 1000},
+      {.dist = OVERFLOW_DIST_NORMAL, .seed = 2, .a = 1e6, .b = 1e4},
+      {.dist = OVERFLOW_DIST_LOGNORMAL, .seed = 3, .a = 5, .b = 1},
+      {.dist = OVERFLOW_DIST_ZIPF, .seed = 4, .a = 1.2, .range = 100},
+      {.dist = OVERFLOW_DIST_ZIPF, .seed = 5, .a = 1.0, .range = 1000},
+  };
+  int nspecs = sizeof(specs) / sizeof(specs[0]);
+  uint32_t *a = malloc(sizeof(uint32_t) * N);
+  uint32_t *b = malloc(sizeof(uint32_t) * N);
+
+  // Same keys for any thread count
+  for (int s = 0; s < nspecs; ++s) {
+    overflow_dataset_generate(a, N, &specs[s], 1);
+    overflow_dataset_generate(b, N, &specs[s], 3);
+    check(memcmp(a, b, sizeof(uint32_t) * N) == 0, "thread-count determinism");
+  }
+
+  // Uniform stays in range and covers it evenly
+  size_t hist[1000] = {0};
+  overflow_dataset_generate(a, N, &specs[0], 0);
+  int in_range = 1;
+  for (size_t i = 0; i < N; ++i) {
+    in_range &= a[i] < 1000;
+    if (a[i] < 1000)
+      hist[a[i]]++;
+  }
+  check(in_range, "uniform range");
+  size_t lo = N, hi = 0;
+  for (int v = 0; v < 1000; ++v) {
+    lo = hist[v] < lo ? hist[v] : lo;
+    hi = hist[v] > hi ? hist[v] : hi;
+  }
+  check(lo > 200 && hi < 400, "uniform spread");
+
+  // Normal moments
+  double sum = 0, sq = 0;
+  overflow_dataset_generate(a, N, &specs[1], 0);
+  for (size_t i = 0; i < N; ++i) {
+    sum += a[i];
+    sq += (double)a[i] * a[i];
+  }
+  double mean = sum / N;
+  double sd = sqrt(sq / N - mean * mean);
+  check(fabs(mean - 1e6) < 100 && fabs(sd - 1e4) < 200, "normal moments");
+
+  // Lognormal: the log of the keys is N(5, 1)
+  sum = sq = 0;
+  overflow_dataset_generate(a, N, &specs[2], 0);
+  for (size_t i = 0; i < N; ++i) {
+    double l = log(a[i] + 0.5);
+    sum += l;
+    sq += l * l;
+  }
+  mean = sum / N;
+  sd = sqrt(sq / N - mean * mean);
+  check(fabs(mean - 5) < 0.05 && fabs(sd - 1) < 0.05, "lognormal moments");
+
+  // Zipf: in range, rank frequencies fall off
+  for (int s = 3; s < nspecs; ++s) {
+    size_t counts[1000] = {0};
+    overflow_dataset_generate(a, N, &specs[s], 0);
+    in_range = 1;
+    for (size_t i = 0; i < N; ++i) {
+      in_range &= a[i] < specs[s].range;
+      if (a[i] < specs[s].range)
+        counts[a[i]]++;
+    }
+    check(in_range, "zipf range");
+    check(counts[0] > counts[1] && counts[1] > counts[9] &&
+              counts[9] > counts[90],
+          "zipf ordering");
+  }
+
+  // Cache: first load writes the file, later loads map it, writes to the
+  // mapping stay private
+  char dir[] = "/tmp/overflow_dataset_XXXXXX";
+  check(mkdtemp(dir) != NULL, "mkdtemp");
+  overflow_dataset_generate(b, N, &specs[1], 0);
+  for (int round = 0; round < 3; ++round) {
+    uint32_t *keys = overflow_dataset_load(dir, N, &specs[1], 0);
+    check(keys && memcmp(keys, b, sizeof(uint32_t) * N) == 0, "cached load");
+    if (keys)
+      keys[0] ^= 1;
+    overflow_dataset_release(keys, N);
+  }
+  uint32_t *plain = overflow_dataset_load("", N, &specs[1], 0);
+  check(plain && memcmp(plain, b, sizeof(uint32_t) * N) == 0,
+        "uncached load");
+  overflow_dataset_release(plain, N);
+
+  char cmd[64];
+  snprintf(cmd, sizeof(cmd), "rm -rf %s", dir);
+  check(system(cmd) == 0, "cache cleanup");
+
+  free(a);
+  free(b);
+  if (!failures)
+    printf("test_dataset: OK\n");
+  return failures ? 1 : 0;
+}
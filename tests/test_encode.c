@@ -0,0 +1,92 @@
+/**
+ * @file test_encode.c
+ * @brief Round-trips sorted keys through both delta encodings.
+ *
+ * For several distributions and sizes around the block and insertion-sort
+ * boundaries, overflow_sort_encode_u32() must produce the same bytes as
+ * encoding a sorted copy, stay within OVERFLOW_ENCODE_MAX_BYTES, and
+ * decode back to the sorted keys.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "overflow_encode.h"
+#include "overflow_engine.h"
+
+#define SIZE 100000
+
+static uint32_t keys[SIZE], sorted[SIZE], decoded[SIZE];
+static uint8_t fused[OVERFLOW_ENCODE_MAX_BYTES(SIZE)];
+static uint8_t plain[OVERFLOW_ENCODE_MAX_BYTES(SIZE)];
+
+static uint32_t random_key(int dist) {
+  uint32_t r = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+  switch (dist) {
+  case 0:
+    return r; // Full range, large gaps
+  case 1:
+    return r % 300; // Runs of duplicates
+  case 2:
+    return r % 7 == 0 ? (r % 2 ? 0 : UINT32_MAX) : 5000000 + r % 100000;
+  default:
+    return r >> (r % 32); // Every tick
+  }
+}
+
+static int check(int dist, size_t n, unsigned encoding) {
+  size_t fused_bytes, plain_bytes;
+
+  for (size_t i = 0; i < n; ++i)
+    keys[i] = sorted[i] = random_key(dist);
+  overflow_sort_u32(sorted, n);
+
+  if (overflow_sort_encode_u32(keys, n, encoding, fused, &fused_bytes) != 0 ||
+      overflow_encode_sorted_u32(sorted, n, encoding, plain, &plain_bytes) !=
+          0) {
+    printf("FAIL: dist %d n=%zu encoding %u returned -1\n", dist, n,
+           encoding);
+    return 1;
+  }
+  if (fused_bytes != plain_bytes ||
+      memcmp(fused, plain, fused_bytes) != 0 ||
+      fused_bytes > OVERFLOW_ENCODE_MAX_BYTES(n)) {
+    printf("FAIL: dist %d n=%zu encoding %u: %zu bytes, %zu from sorted\n",
+           dist, n, encoding, fused_bytes, plain_bytes);
+    return 1;
+  }
+  if (overflow_decode_u32(fused, n, encoding, decoded) != fused_bytes ||
+      memcmp(decoded, sorted, n * sizeof(uint32_t)) != 0) {
+    printf("FAIL: dist %d n=%zu encoding %u decode\n", dist, n, encoding);
+    return 1;
+  }
+  return 0;
+}
+
+int main(void) {
+  static const size_t sizes[] = {0, 1, 47, 49, 128, 129, 1000, SIZE};
+  int failures = 0;
+  size_t written;
+
+  srand(49);
+  for (int dist = 0; dist < 4; ++dist)
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+      for (unsigned encoding = 0; encoding <= OVERFLOW_ENCODE_BLOCKS;
+           ++encoding)
+        failures += check(dist, sizes[i], encoding);
+
+  if (overflow_sort_encode_u32(keys, 10, 7, fused, &written) != -1) {
+    printf("FAIL: accepted an unknown encoding\n");
+    failures++;
+  }
+
+  if (!failures)
+    printf("test_encode: OK\n");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,169 @@
+/**
+ * @file test_heap.c
+ * @brief Checks the radix heaps on random monotone workloads.
+ *
+ * Pushes and pops are interleaved with every new key at or above the last
+ * one popped, as in Dijkstra. The popped keys must never decrease, each
+ * payload must still belong to its key, and once drained the popped keys
+ * must be the pushed keys. Since a later push can't go below the last pop,
+ * that is only possible if every pop took a minimum.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "overflow_heap.h"
+
+#define MAX_OPS 300000
+
+static uint64_t pushed[MAX_OPS], popped[MAX_OPS];
+
+static uint64_t next_random(uint64_t *s) {
+  *s ^= *s << 13;
+  *s ^= *s >> 7;
+  *s ^= *s << 17;
+  return *s;
+}
+
+static uint32_t payload_of(uint64_t key) {
+  return (uint32_t)(key * 0x9E3779B97F4A7C15ull >> 32);
+}
+
+static int cmp_u64(const void *a, const void *b) {
+  uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+  return (x > y) - (x < y);
+}
+
+// Offset above the last pop: mostly small steps, some duplicates, some
+// jumps across many ticks.
+static uint64_t random_step(uint64_t *s, unsigned bits) {
+  uint64_t r = next_random(s);
+  switch (r % 4) {
+  case 0:
+    return 0;
+  case 1:
+    return r >> 8 & 255;
+  default:
+    return (r >> 8) >> (r % bits) & (bits == 64 ? UINT64_MAX
+                                                : ((uint64_t)1 << bits) - 1);
+  }
+}
+
+static int check_sequence(const char *name, size_t pushes, size_t pops) {
+  for (size_t i = 1; i < pops; ++i)
+    if (popped[i] < popped[i - 1]) {
+      printf("FAIL: %s pop %zu decreased\n", name, i);
+      return 1;
+    }
+  if (pushes != pops) {
+    printf("FAIL: %s pushed %zu, popped %zu\n", name, pushes, pops);
+    return 1;
+  }
+  qsort(pushed, pushes, sizeof(uint64_t), cmp_u64);
+  if (memcmp(pushed, popped, pops * sizeof(uint64_t)) != 0) {
+    printf("FAIL: %s popped keys differ from pushed\n", name);
+    return 1;
+  }
+  return 0;
+}
+
+static int check_u32(unsigned burst) {
+  overflow_radix_heap_u32 *h = overflow_radix_heap_create_u32();
+  uint64_t s = 0x243F6A8885A308D3ull + burst;
+  size_t pushes = 0, pops = 0;
+  uint32_t last = 0, key, payload;
+  int failures = 0;
+
+  if (overflow_radix_heap_pop_u32(h, &key, &payload) != -1) {
+    printf("FAIL: u32 pop on empty heap\n");
+    failures++;
+  }
+  while (pushes < MAX_OPS && !failures) {
+    unsigned k = 1 + (unsigned)(next_random(&s) % burst);
+    for (unsigned i = 0; i < k && pushes < MAX_OPS; ++i) {
+      uint64_t v = last + random_step(&s, 32);
+      key = v > UINT32_MAX ? UINT32_MAX : (uint32_t)v;
+      if (overflow_radix_heap_push_u32(h, key, payload_of(key)) != 0)
+        failures++;
+      pushed[pushes++] = key;
+    }
+    k = (unsigned)(next_random(&s) % burst);
+    for (unsigned i = 0; i < k && overflow_radix_heap_size_u32(h); ++i) {
+      overflow_radix_heap_pop_u32(h, &key, &payload);
+      if (payload != payload_of(key))
+        failures++;
+      popped[pops++] = last = key;
+    }
+    if (last && overflow_radix_heap_push_u32(h, last - 1, 0) != -1) {
+      printf("FAIL: u32 accepted a key below the last pop\n");
+      failures++;
+    }
+  }
+  if (overflow_radix_heap_size_u32(h) != pushes - pops)
+    failures++;
+  while (overflow_radix_heap_pop_u32(h, &key, &payload) == 0) {
+    if (payload != payload_of(key))
+      failures++;
+    popped[pops++] = key;
+  }
+  overflow_radix_heap_destroy_u32(h);
+  if (failures)
+    printf("FAIL: u32 burst %u\n", burst);
+  return failures + check_sequence("u32", pushes, pops);
+}
+
+static int check_u64(unsigned burst) {
+  overflow_radix_heap_u64 *h = overflow_radix_heap_create_u64();
+  uint64_t s = 0x13198A2E03707344ull + burst;
+  size_t pushes = 0, pops = 0;
+  uint64_t last = 0, key;
+  uint32_t payload;
+  int failures = 0;
+
+  while (pushes < MAX_OPS && !failures) {
+    unsigned k = 1 + (unsigned)(next_random(&s) % burst);
+    for (unsigned i = 0; i < k && pushes < MAX_OPS; ++i) {
+      uint64_t step = random_step(&s, 64);
+      key = step > UINT64_MAX - last ? UINT64_MAX : last + step;
+      if (overflow_radix_heap_push_u64(h, key, payload_of(key)) != 0)
+        failures++;
+      pushed[pushes++] = key;
+    }
+    k = (unsigned)(next_random(&s) % burst);
+    for (unsigned i = 0; i < k && overflow_radix_heap_size_u64(h); ++i) {
+      overflow_radix_heap_pop_u64(h, &key, &payload);
+      if (payload != payload_of(key))
+        failures++;
+      popped[pops++] = last = key;
+    }
+  }
+  while (overflow_radix_heap_pop_u64(h, &key, &payload) == 0) {
+    if (payload != payload_of(key))
+      failures++;
+    popped[pops++] = key;
+  }
+  overflow_radix_heap_destroy_u64(h);
+  if (failures)
+    printf("FAIL: u64 burst %u\n", burst);
+  return failures + check_sequence("u64", pushes, pops);
+}
+
+int main(void) {
+  static const unsigned bursts[] = {1, 3, 40, 5000};
+  int failures = 0;
+
+  for (size_t i = 0; i < sizeof(bursts) / sizeof(bursts[0]); ++i) {
+    failures += check_u32(bursts[i]);
+    failures += check_u64(bursts[i]);
+  }
+
+  if (!failures)
+    printf("test_heap: OK\n");
+  return failures ? 1 : 0;
+}
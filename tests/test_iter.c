@@ -0,0 +1,94 @@
+/**
+ * @file test_iter.c
+ * @brief Checks lazy sorted iteration against qsort.
+ *
+ * Reads every input in uneven batches mixed with skips and compares each
+ * returned key with its rank in the qsort answer.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "overflow_iter.h"
+
+int cmp_uint32(const void *a, const void *b) {
+  uint32_t ua = *(const uint32_t *)a;
+  uint32_t ub = *(const uint32_t *)b;
+  return (ua > ub) - (ua < ub);
+}
+
+static int check(const char *name, const uint32_t *keys, size_t n) {
+  uint32_t *expect = malloc((n + 1) * sizeof(uint32_t));
+  uint32_t *got = malloc((n + 1) * sizeof(uint32_t));
+  int failures = 0;
+
+  memcpy(expect, keys, n * sizeof(uint32_t));
+  qsort(expect, n, sizeof(uint32_t), cmp_uint32);
+
+  // Plain batched reads
+  overflow_sorted_iter *it = overflow_sorted_iter_create(keys, n);
+  size_t total = 0, len;
+  while ((len = overflow_sorted_iter_next(it, got + total, 1 + total % 977)))
+    total += len;
+  if (total != n || memcmp(got, expect, n * sizeof(uint32_t)) != 0 ||
+      overflow_sorted_iter_remaining(it) != 0) {
+    printf("FAIL: %s n=%zu batched read\n", name, n);
+    failures++;
+  }
+  overflow_sorted_iter_destroy(it);
+
+  // Pages: skip some, read some
+  it = overflow_sorted_iter_create(keys, n);
+  size_t pos = 0;
+  for (size_t step = 0; pos < n; ++step) {
+    size_t skip = (step * 7919) % 50000;
+    pos += overflow_sorted_iter_skip(it, skip);
+    size_t len = overflow_sorted_iter_next(it, got, 1 + step % 300);
+    if (pos + len > n || memcmp(got, &expect[pos], len * sizeof(uint32_t))) {
+      printf("FAIL: %s n=%zu page at %zu\n", name, n, pos);
+      failures++;
+      break;
+    }
+    pos += len;
+  }
+  if (overflow_sorted_iter_skip(it, 5) != 0 ||
+      overflow_sorted_iter_next(it, got, 5) != 0) {
+    printf("FAIL: %s n=%zu iterator not exhausted\n", name, n);
+    failures++;
+  }
+  overflow_sorted_iter_destroy(it);
+
+  free(expect);
+  free(got);
+  return failures;
+}
+
+int main() {
+  size_t sizes[] = {0, 1, 2, 49, 1000, 1000003};
+  int failures = 0;
+
+  srand(43);
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+    size_t n = sizes[s];
+    uint32_t *keys = malloc((n + 1) * sizeof(uint32_t));
+    for (size_t i = 0; i < n; ++i) {
+      uint32_t r = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+      keys[i] = i % 3 == 0 ? r : i % 3 == 1 ? r % 700 : r >> (r % 32);
+    }
+    failures += check("mixed", keys, n);
+    for (size_t i = 0; i < n; ++i)
+      keys[i] = 0xfffffff0u + (uint32_t)(rand() % 16);
+    failures += check("top", keys, n);
+    free(keys);
+  }
+
+  if (!failures)
+    printf("test_iter: OK\n");
+  return failures ? 1 : 0;
+}
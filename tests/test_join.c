@@ -0,0 +1,157 @@
+/**
+ * @file test_join.c
+ * @brief Checks overflow_join_u32() against a nested-loop join.
+ *
+ * Small columns from several key distributions (heavy duplicates, narrow
+ * ranges far from zero, full range, every tick) are joined in both modes and
+ * with one and four workers. The expected pairs come from a nested loop,
+ * ordered as documented: by key, then left row, then right row. Large
+ * columns, whose partitions are big enough for the radix sort, are checked
+ * against a qsort of row indices instead.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "overflow_join.h"
+
+#define MAX_ROWS 3000
+#define BIG_ROWS 200000
+
+static uint32_t left[BIG_ROWS], right[BIG_ROWS];
+static uint32_t order_l[BIG_ROWS], order_r[BIG_ROWS];
+static overflow_join_pair want[BIG_ROWS * 4];
+
+static uint32_t random_u32(void) {
+  return ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+}
+
+static uint32_t random_key(int dist) {
+  uint32_t r = random_u32();
+  switch (dist) {
+  case 0:
+    return r % 50; // Heavy duplicates, including 0
+  case 1:
+    return 3000000000u + r % 4000; // Narrow range near the top
+  case 2:
+    return r % 2 ? r : r % 20000; // Full range plus a dense core
+  case 3:
+    return 1000000000u + r % (1u << 22); // Wide bins far from zero
+  default:
+    return r >> (r % 32); // Every tick
+  }
+}
+
+static int cmp_pair(const void *a, const void *b) {
+  const overflow_join_pair *x = a, *y = b;
+  if (left[x->left] != left[y->left])
+    return left[x->left] < left[y->left] ? -1 : 1;
+  if (x->left != y->left)
+    return x->left < y->left ? -1 : 1;
+  return (x->right > y->right) - (x->right < y->right);
+}
+
+static size_t nested_loop(size_t nl, size_t nr, unsigned mode) {
+  size_t count = 0;
+  for (size_t i = 0; i < nl; ++i)
+    for (size_t j = 0; j < nr; ++j)
+      if (left[i] == right[j]) {
+        want[count++] = (overflow_join_pair){(uint32_t)i, (uint32_t)j};
+        if (mode == OVERFLOW_JOIN_SEMI)
+          break;
+      }
+  qsort(want, count, sizeof(overflow_join_pair), cmp_pair);
+  return count;
+}
+
+static int cmp_left(const void *a, const void *b) {
+  uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+  if (left[x] != left[y])
+    return left[x] < left[y] ? -1 : 1;
+  return (x > y) - (x < y);
+}
+
+static int cmp_right(const void *a, const void *b) {
+  uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+  if (right[x] != right[y])
+    return right[x] < right[y] ? -1 : 1;
+  return (x > y) - (x < y);
+}
+
+// Merges both columns in (key, row) order, like the join itself.
+static size_t sorted_merge(size_t nl, size_t nr, unsigned mode) {
+  size_t count = 0, j = 0;
+  for (uint32_t i = 0; i < nl; ++i)
+    order_l[i] = i;
+  for (uint32_t i = 0; i < nr; ++i)
+    order_r[i] = i;
+  qsort(order_l, nl, sizeof(uint32_t), cmp_left);
+  qsort(order_r, nr, sizeof(uint32_t), cmp_right);
+
+  for (size_t i = 0; i < nl; ++i) {
+    uint32_t key = left[order_l[i]];
+    while (j < nr && right[order_r[j]] < key)
+      j++;
+    for (size_t k = j; k < nr && right[order_r[k]] == key; ++k) {
+      want[count++] = (overflow_join_pair){order_l[i], order_r[k]};
+      if (mode == OVERFLOW_JOIN_SEMI)
+        break;
+    }
+  }
+  return count;
+}
+
+static int check(int dist, size_t nl, size_t nr, unsigned mode,
+                 unsigned threads) {
+  overflow_join_pair *got;
+  size_t n, expect = nl <= MAX_ROWS ? nested_loop(nl, nr, mode)
+                                    : sorted_merge(nl, nr, mode);
+
+  if (overflow_join_u32(left, nl, right, nr, mode, threads, &got, &n) != 0) {
+    printf("FAIL: dist %d nl=%zu nr=%zu join returned -1\n", dist, nl, nr);
+    return 1;
+  }
+  int bad = n != expect ||
+            (n && memcmp(got, want, n * sizeof(overflow_join_pair)) != 0);
+  if (bad)
+    printf("FAIL: dist %d nl=%zu nr=%zu mode %u threads %u: %zu pairs, "
+           "expected %zu\n",
+           dist, nl, nr, mode, threads, n, expect);
+  free(got);
+  return bad;
+}
+
+int main(void) {
+  static const size_t sizes[][2] = {{0, 5}, {1, 1}, {20, 7}, {700, 900},
+                                    {3000, 2500}, {BIG_ROWS, 150000}};
+  int failures = 0;
+
+  srand(46);
+  for (int dist = 0; dist < 5; ++dist)
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+      size_t nl = sizes[s][0], nr = sizes[s][1];
+      // Heavy duplicates on large columns would overflow `want`
+      if (dist == 0 && nl * nr > 100000)
+        continue;
+      if (nl > MAX_ROWS && dist != 2 && dist != 3)
+        continue;
+      for (size_t i = 0; i < nl; ++i)
+        left[i] = random_key(dist);
+      for (size_t i = 0; i < nr; ++i)
+        right[i] = random_key(dist);
+      for (unsigned mode = 0; mode < 2; ++mode) {
+        failures += check(dist, nl, nr, mode, 1);
+        failures += check(dist, nl, nr, mode, 4);
+      }
+    }
+
+  if (!failures)
+    printf("test_join: OK\n");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,141 @@
+/**
+ * @file test_multiset.c
+ * @brief Checks the ordered multiset against a plain sorted array.
+ *
+ * Random batches of inserts and erases (with duplicates, absent keys and
+ * every tick) are mirrored into a sorted reference array; after each batch
+ * rank, select and lower_bound are compared at random probes.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "overflow_multiset.h"
+
+#define MAX_KEYS 400000
+
+static uint32_t ref[MAX_KEYS];
+static size_t ref_n;
+
+static uint32_t random_key(void) {
+  uint32_t r = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+  switch (r % 4) {
+  case 0:
+    return r % 64; // Heavy duplicates
+  case 1:
+    return r >> (r % 32);
+  default:
+    return 1000000 + r % 5000;
+  }
+}
+
+static size_t ref_rank(uint32_t key) {
+  size_t lo = 0, hi = ref_n;
+  while (lo < hi) {
+    size_t mid = (lo + hi) / 2;
+    if (ref[mid] < key)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+static void ref_insert(uint32_t key) {
+  size_t at = ref_rank(key);
+  memmove(&ref[at + 1], &ref[at], (ref_n - at) * sizeof(uint32_t));
+  ref[at] = key;
+  ref_n++;
+}
+
+static int ref_erase(uint32_t key) {
+  size_t at = ref_rank(key);
+  if (at == ref_n || ref[at] != key)
+    return 0;
+  memmove(&ref[at], &ref[at + 1], (ref_n - at - 1) * sizeof(uint32_t));
+  ref_n--;
+  return 1;
+}
+
+static int check_queries(overflow_multiset *ms, int round) {
+  if (overflow_multiset_size(ms) != ref_n) {
+    printf("FAIL: round %d size %zu, expected %zu\n", round,
+           overflow_multiset_size(ms), ref_n);
+    return 1;
+  }
+  for (int q = 0; q < 300; ++q) {
+    uint32_t key = q % 3 ? random_key() : ref_n ? ref[rand() % ref_n] : 0;
+    size_t rank = ref_rank(key), k = ref_n ? (size_t)rand() % ref_n : 0;
+    uint32_t got = 0, lb = 0;
+    int has_lb = overflow_multiset_lower_bound(ms, key, &lb) == 0;
+
+    if (overflow_multiset_rank(ms, key) != rank ||
+        has_lb != (rank < ref_n) || (has_lb && lb != ref[rank]) ||
+        (ref_n && (overflow_multiset_select(ms, k, &got) != 0 ||
+                   got != ref[k]))) {
+      printf("FAIL: round %d query key=%u k=%zu\n", round, key, k);
+      return 1;
+    }
+  }
+  if (overflow_multiset_select(ms, ref_n, &(uint32_t){0}) != -1) {
+    printf("FAIL: round %d select past the end\n", round);
+    return 1;
+  }
+  return 0;
+}
+
+int main() {
+  static uint32_t batch[50000];
+  overflow_multiset *ms = overflow_multiset_create();
+  int failures = 0;
+
+  srand(44);
+  for (int round = 0; round < 120 && !failures; ++round) {
+    size_t n = round % 10 == 0 ? 20000 : (size_t)(rand() % 700);
+    for (size_t i = 0; i < n; ++i)
+      batch[i] = random_key();
+
+    if (round % 3 == 2) {
+      // Erase a mix of present and absent keys
+      for (size_t i = 0; i < n && ref_n; i += 2)
+        batch[i] = ref[rand() % ref_n];
+      size_t removed = 0, expect = 0;
+      if (overflow_multiset_erase(ms, batch, n, &removed) != 0)
+        failures++;
+      for (size_t i = 0; i < n; ++i)
+        expect += ref_erase(batch[i]);
+      if (removed != expect) {
+        printf("FAIL: round %d removed %zu, expected %zu\n", round, removed,
+               expect);
+        failures++;
+      }
+    } else {
+      if (overflow_multiset_insert(ms, batch, n) != 0)
+        failures++;
+      for (size_t i = 0; i < n; ++i)
+        ref_insert(batch[i]);
+    }
+    failures += check_queries(ms, round);
+  }
+
+  // Drain everything through select() order
+  while (!failures && ref_n) {
+    size_t n = ref_n < 5000 ? ref_n : 5000;
+    memcpy(batch, ref, n * sizeof(uint32_t));
+    overflow_multiset_erase(ms, batch, n, NULL);
+    memmove(ref, &ref[n], (ref_n - n) * sizeof(uint32_t));
+    ref_n -= n;
+    failures += check_queries(ms, -1);
+  }
+
+  overflow_multiset_destroy(ms);
+  if (!failures)
+    printf("test_multiset: OK\n");
+  return failures ? 1 : 0;
+}
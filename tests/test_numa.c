@@ -0,0 +1,178 @@
+/**
+ * @file test_numa.c
+ * @brief Checks NUMA topology parsing and the placement-aware parallel sort.
+ *
+ * The multi-node cases use a fake two-node topology (OVERFLOW_NUMA syntax),
+ * so they run on single-node machines too: pinning to CPUs that don't exist
+ * fails and the sort must still produce the right answer.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "overflow_dataset.h"
+#include "overflow_numa.h"
+#include "overflow_parallel.h"
+#include "overflow_tick.h"
+
+#define SIZE (2000000 + 123)
+
+int cmp_uint32(const void *a, const void *b) {
+  uint32_t ua = *(const uint32_t *)a;
+  uint32_t ub = *(const uint32_t *)b;
+  return (ua > ub) - (ua < ub);
+}
+
+static int check_parse(void) {
+  overflow_numa_topology topo;
+  int failures = 0;
+
+  if (overflow_numa_parse(&topo, "0-3,8-11;4-7") != 0 || topo.nodes != 2 ||
+      topo.cpus != 12 || topo.cpu[4] != 8 || topo.node[4] != 0 ||
+      topo.cpu[8] != 4 || topo.node[8] != 1) {
+    printf("FAIL: parse of two-node cpulist\n");
+    failures++;
+  }
+  if (overflow_numa_parse(&topo, "0-x") == 0 ||
+      overflow_numa_parse(&topo, "5-2") == 0 ||
+      overflow_numa_parse(&topo, "") == 0) {
+    printf("FAIL: malformed specs accepted\n");
+    failures++;
+  }
+
+  setenv("OVERFLOW_NUMA", "0-3;4-7", 1);
+  overflow_numa_detect(&topo);
+  if (topo.nodes != 2 || topo.cpus != 8) {
+    printf("FAIL: OVERFLOW_NUMA override ignored\n");
+    failures++;
+  }
+  unsetenv("OVERFLOW_NUMA");
+  overflow_numa_detect(&topo);
+  if (topo.nodes < 1 || topo.cpus < 1) {
+    printf("FAIL: detection without override found no CPUs\n");
+    failures++;
+  }
+
+  int cpu[4];
+  unsigned node[4];
+  overflow_numa_parse(&topo, "0-3;4-7");
+  overflow_numa_plan(&topo, 4, cpu, node);
+  if (cpu[0] != 0 || cpu[1] != 2 || cpu[2] != 4 || cpu[3] != 6 ||
+      node[0] != 0 || node[1] != 0 || node[2] != 1 || node[3] != 1) {
+    printf("FAIL: worker plan not node-ordered\n");
+    failures++;
+  }
+  return failures;
+}
+
+static int check_sort(const char *name, const overflow_numa_topology *topo,
+                      unsigned placement, unsigned expect_nodes) {
+  overflow_parallel_stats stats;
+  overflow_parallel_opts opts = {.threads = 4,
+                                 .placement = placement,
+                                 .topology = topo,
+                                 .stats = &stats};
+  uint32_t *keys = overflow_numa_alloc_u32(SIZE, &opts);
+  uint32_t *scratch = overflow_numa_alloc_u32(SIZE, &opts);
+  uint32_t *expect = malloc(sizeof(uint32_t) * SIZE);
+  int failures = 0;
+
+  srand(99);
+  for (size_t i = 0; i < SIZE; ++i) {
+    uint32_t r = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+    keys[i] = i % 4 == 0 ? r % 512 : r >> (r % 28);
+  }
+  memcpy(expect, keys, sizeof(uint32_t) * SIZE);
+  qsort(expect, SIZE, sizeof(uint32_t), cmp_uint32);
+
+  if (overflow_sort_parallel_opts_u32(keys, SIZE, scratch, &opts) != 0 ||
+      memcmp(keys, expect, sizeof(uint32_t) * SIZE) != 0) {
+    printf("FAIL: %s: output differs from qsort\n", name);
+    failures++;
+  }
+  if (stats.threads != 4 || stats.pinned > stats.threads ||
+      (expect_nodes && stats.nodes != expect_nodes)) {
+    printf("FAIL: %s: stats threads=%u nodes=%u pinned=%u\n", name,
+           stats.threads, stats.nodes, stats.pinned);
+    failures++;
+  }
+
+  overflow_numa_free(keys, SIZE);
+  overflow_numa_free(scratch, SIZE);
+  free(expect);
+  return failures;
+}
+
+// Normal keys pile into one or two ticks; splitting them must keep the
+// output sorted and bring the largest partition near n / threads.
+static int check_skew(unsigned placement) {
+  overflow_dataset_spec spec = {.dist = OVERFLOW_DIST_NORMAL,
+                                .seed = 7,
+                                .a = 3000000,
+                                .b = 200000};
+  overflow_parallel_stats split, whole;
+  overflow_parallel_opts opts = {
+      .threads = 4, .placement = placement, .stats = &split};
+  uint32_t *keys = malloc(sizeof(uint32_t) * SIZE);
+  uint32_t *scratch = malloc(sizeof(uint32_t) * SIZE);
+  uint32_t *expect = malloc(sizeof(uint32_t) * SIZE);
+  int failures = 0;
+
+  overflow_dataset_generate(expect, SIZE, &spec, 1);
+  memcpy(keys, expect, sizeof(uint32_t) * SIZE);
+  qsort(expect, SIZE, sizeof(uint32_t), cmp_uint32);
+
+  overflow_sort_parallel_opts_u32(keys, SIZE, scratch, &opts);
+  if (memcmp(keys, expect, sizeof(uint32_t) * SIZE) != 0) {
+    printf("FAIL: skewed split sort differs from qsort\n");
+    failures++;
+  }
+
+  overflow_dataset_generate(keys, SIZE, &spec, 1);
+  opts.tick_only = 1;
+  opts.stats = &whole;
+  overflow_sort_parallel_opts_u32(keys, SIZE, scratch, &opts);
+  if (memcmp(keys, expect, sizeof(uint32_t) * SIZE) != 0) {
+    printf("FAIL: skewed tick-only sort differs from qsort\n");
+    failures++;
+  }
+
+  if (split.partitions <= OVERFLOW_TICKS_U32 || split.imbalance > 1.0 ||
+      whole.partitions != OVERFLOW_TICKS_U32 || whole.imbalance < 2.0) {
+    printf("FAIL: skew stats: split %u parts %.2f, tick-only %u parts "
+           "%.2f\n",
+           split.partitions, split.imbalance, whole.partitions,
+           whole.imbalance);
+    failures++;
+  }
+
+  free(keys);
+  free(scratch);
+  free(expect);
+  return failures;
+}
+
+int main() {
+  overflow_numa_topology fake;
+  int failures = check_parse();
+
+  overflow_numa_parse(&fake, "0-3;4-7");
+  failures += check_sort("fake 2-node, full placement", &fake,
+                         OVERFLOW_PLACE_NUMA, 2);
+  failures += check_sort("fake 2-node, local only", &fake,
+                         OVERFLOW_PLACE_LOCAL, 2);
+  failures += check_sort("detected topology", NULL, OVERFLOW_PLACE_NUMA, 0);
+  failures += check_sort("no placement", NULL, 0, 0);
+  failures += check_skew(0);
+  failures += check_skew(OVERFLOW_PLACE_LOCAL);
+
+  if (!failures)
+    printf("test_numa: OK\n");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,103 @@
+"""
+Checks the _overflow extension against numpy.sort / numpy.argsort.
+
+Run with `make test_python`.
+"""
+
+import array
+import sys
+import threading
+
+import numpy as np
+
+import overflow_np
+
+DTYPES = [np.uint8, np.uint16, np.uint32, np.uint64, np.int8, np.int16,
+          np.int32, np.int64, np.float32, np.float64]
+SIZES = [0, 1, 2, 17, 49, 1000, 300_001]
+
+failures = 0
+
+
+def check(ok, what):
+    global failures
+    if not ok:
+        print("FAIL:", what)
+        failures += 1
+
+
+def make_keys(dtype, n, rng):
+    if np.issubdtype(dtype, np.floating):
+        a = rng.standard_normal(n).astype(dtype) * 1000
+        if n > 10:
+            a[::7] = np.round(a[::7])  # duplicates
+            a[3] = np.nan
+            a[5] = -np.nan
+            a[8], a[9] = -0.0, 0.0
+            a[10] = -np.inf
+        return a
+    info = np.iinfo(dtype)
+    a = rng.integers(info.min, info.max, n, dtype=dtype, endpoint=True)
+    a[::3] %= dtype(7)  # duplicates
+    return a
+
+
+rng = np.random.default_rng(11)
+for dtype in DTYPES:
+    for n in SIZES:
+        keys = make_keys(dtype, n, rng)
+        for threads in (1, 0, 3):
+            a = keys.copy()
+            overflow_np.sort(a, threads)
+            check(np.array_equal(a, np.sort(keys), equal_nan=True),
+                  f"sort {np.dtype(dtype).name} n={n} threads={threads}")
+            if np.issubdtype(dtype, np.floating):
+                # Values are moved, never rewritten: NaN signs survive
+                bits = np.dtype(f"u{np.dtype(dtype).itemsize}")
+                check(np.array_equal(np.sort(a.view(bits)),
+                                     np.sort(keys.view(bits))),
+                      f"sort {np.dtype(dtype).name} n={n} kept bit patterns")
+
+            idx = overflow_np.argsort(keys, threads)
+            check(np.array_equal(idx, np.argsort(keys, kind="stable")),
+                  f"argsort {np.dtype(dtype).name} n={n} threads={threads}")
+
+# Any buffer works, not just NumPy
+buf = array.array("I", [5, 3, 9, 1])
+overflow_np.sort(buf)
+check(list(buf) == [1, 3, 5, 9], "array.array")
+
+# Rejected inputs
+for bad, exc in [(np.arange(10)[::2], (BufferError, ValueError)),
+                 (np.zeros((2, 2), dtype=np.int32), ValueError),
+                 (np.zeros(4, dtype=np.complex64), TypeError),
+                 (np.zeros(4, dtype=">u4"), TypeError)]:
+    try:
+        overflow_np.sort(bad)
+        check(False, f"accepted {bad.dtype} shape {bad.shape}")
+    except exc:
+        pass
+
+readonly = np.arange(10, dtype=np.int32)
+readonly.flags.writeable = False
+try:
+    overflow_np.sort(readonly)
+    check(False, "sorted a read-only array")
+except (BufferError, ValueError):
+    pass
+check(np.array_equal(overflow_np.argsort(readonly), np.arange(10)),
+      "argsort of a read-only array")
+
+# The GIL is released, so Python threads overlap their sorts
+arrays = [make_keys(np.int64, 1_000_000, rng) for _ in range(4)]
+workers = [threading.Thread(target=overflow_np.sort, args=(a, 1))
+           for a in arrays]
+for w in workers:
+    w.start()
+for w in workers:
+    w.join()
+check(all(np.all(a[:-1] <= a[1:]) for a in arrays), "concurrent sorts")
+
+if failures:
+    sys.exit(1)
+print("test_numpy: OK")
@@ -0,0 +1,87 @@
+/**
+ * @file test_partition.c
+ * @brief Checks overflow_partition_log2() class by class.
+ *
+ * For several sub-class counts and worker counts, every class range must
+ * hold exactly the keys of that class, in input order, with index output
+ * naming the same rows that key output copies.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "overflow_partition.h"
+
+#define SIZE 600000
+
+static uint32_t keys[SIZE], out_keys[SIZE], out_rows[SIZE];
+static size_t offsets[OVERFLOW_PARTITION_CLASSES(OVERFLOW_LOGLIN_SUB_MAX) + 1];
+static size_t row_offsets[OVERFLOW_PARTITION_CLASSES(OVERFLOW_LOGLIN_SUB_MAX) +
+                          1];
+
+static int check(size_t n, unsigned sub_bits, unsigned threads) {
+  unsigned classes = OVERFLOW_PARTITION_CLASSES(sub_bits);
+
+  if (overflow_partition_log2(keys, n, sub_bits, 0, threads, out_keys,
+                              offsets) != 0 ||
+      overflow_partition_log2(keys, n, sub_bits, OVERFLOW_PARTITION_INDICES,
+                              threads, out_rows, row_offsets) != 0) {
+    printf("FAIL: n=%zu sub_bits=%u returned -1\n", n, sub_bits);
+    return 1;
+  }
+  if (offsets[0] != 0 || offsets[classes] != n) {
+    printf("FAIL: n=%zu sub_bits=%u offsets don't span the input\n", n,
+           sub_bits);
+    return 1;
+  }
+  for (unsigned c = 0; c < classes; ++c) {
+    if (offsets[c + 1] < offsets[c] || row_offsets[c] != offsets[c]) {
+      printf("FAIL: n=%zu sub_bits=%u bad offset at class %u\n", n,
+             sub_bits, c);
+      return 1;
+    }
+    for (size_t i = offsets[c]; i < offsets[c + 1]; ++i) {
+      uint32_t row = out_rows[i];
+      if (row >= n || keys[row] != out_keys[i] ||
+          overflow_loglin_u32(out_keys[i], sub_bits) != c ||
+          (i > offsets[c] && row <= out_rows[i - 1])) {
+        printf("FAIL: n=%zu sub_bits=%u threads=%u class %u position %zu\n",
+               n, sub_bits, threads, c, i);
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
+
+int main(void) {
+  static const size_t sizes[] = {0, 1, 1000, 70000, SIZE};
+  static const unsigned sub_bits[] = {0, 1, 4, OVERFLOW_LOGLIN_SUB_MAX};
+  static const unsigned threads[] = {1, 3, 8};
+  int failures = 0;
+
+  srand(47);
+  for (size_t i = 0; i < SIZE; ++i) {
+    uint32_t r = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+    keys[i] = r >> (r % 33 == 32 ? 31 : r % 32); // Every tick, some zeros
+  }
+
+  if (overflow_partition_log2(keys, SIZE, OVERFLOW_LOGLIN_SUB_MAX + 1, 0, 1,
+                              out_keys, offsets) != -1) {
+    printf("FAIL: accepted too many sub-bits\n");
+    failures++;
+  }
+  for (size_t a = 0; a < sizeof(sizes) / sizeof(sizes[0]); ++a)
+    for (size_t b = 0; b < sizeof(sub_bits) / sizeof(sub_bits[0]); ++b)
+      for (size_t c = 0; c < sizeof(threads) / sizeof(threads[0]); ++c)
+        failures += check(sizes[a], sub_bits[b], threads[c]);
+
+  if (!failures)
+    printf("test_partition: OK\n");
+  return failures ? 1 : 0;
+}
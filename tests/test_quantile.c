@@ -0,0 +1,113 @@
+/**
+ * @file test_quantile.c
+ * @brief Checks log-linear quantiles against a sorted copy.
+ *
+ * Exact mode must return the key of each rank; estimates must stay within
+ * the documented relative error for every sub_bits setting. Inputs include
+ * a single key, all-equal keys and the extremes 0 and UINT32_MAX.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "overflow_dataset.h"
+#include "overflow_quantile.h"
+
+static const double qs[] = {0, 0.001, 0.25, 0.5, 0.9, 0.99, 0.999, 1};
+#define NQ (sizeof(qs) / sizeof(qs[0]))
+
+int cmp_uint32(const void *a, const void *b) {
+  uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+  return (x > y) - (x < y);
+}
+
+static int check(const char *name, const uint32_t *keys, size_t n) {
+  uint32_t *sorted = malloc(sizeof(uint32_t) * n);
+  uint32_t got[NQ];
+  int failures = 0;
+
+  memcpy(sorted, keys, sizeof(uint32_t) * n);
+  qsort(sorted, n, sizeof(uint32_t), cmp_uint32);
+
+  for (unsigned s = 0; s <= OVERFLOW_LOGLIN_SUB_MAX; ++s) {
+    if (overflow_quantiles(keys, n, qs, NQ, s, OVERFLOW_QUANTILE_EXACT,
+                           got) != 0) {
+      printf("FAIL: %s exact sub=%u returned an error\n", name, s);
+      failures++;
+      continue;
+    }
+    for (size_t i = 0; i < NQ; ++i) {
+      uint32_t want = sorted[(size_t)(qs[i] * (double)(n - 1) + 0.5)];
+      if (got[i] != want) {
+        printf("FAIL: %s exact sub=%u q=%g: %u != %u\n", name, s, qs[i],
+               got[i], want);
+        failures++;
+      }
+    }
+
+    overflow_quantiles(keys, n, qs, NQ, s, 0, got);
+    for (size_t i = 0; i < NQ; ++i) {
+      uint32_t want = sorted[(size_t)(qs[i] * (double)(n - 1) + 0.5)];
+      double err = (double)got[i] - (double)want;
+      if ((err < 0 ? -err : err) > (double)want / (2u << s)) {
+        printf("FAIL: %s estimate sub=%u q=%g: %u vs %u\n", name, s, qs[i],
+               got[i], want);
+        failures++;
+      }
+    }
+  }
+  free(sorted);
+  return failures;
+}
+
+int main() {
+  size_t n = 1000003;
+  uint32_t *keys = malloc(sizeof(uint32_t) * n);
+  int failures = 0;
+
+  overflow_dataset_spec lognormal = {OVERFLOW_DIST_LOGNORMAL, 40, 9.0, 1.5,
+                                     0};
+  overflow_dataset_generate(keys, n, &lognormal, 1);
+  failures += check("lognormal", keys, n);
+
+  overflow_dataset_spec uniform = {OVERFLOW_DIST_UNIFORM, 40, 0, 0, 0};
+  overflow_dataset_generate(keys, n, &uniform, 1);
+  for (size_t i = 0; i < n; i += 97)
+    keys[i] = i % 2 ? UINT32_MAX : 0;
+  failures += check("uniform+extremes", keys, n);
+
+  for (size_t i = 0; i < 1000; ++i)
+    keys[i] = 123456;
+  failures += check("equal", keys, 1000);
+  failures += check("single", keys, 1);
+
+  if (overflow_quantiles(keys, 0, qs, NQ, 4, 0, keys) != -1) {
+    printf("FAIL: empty input accepted\n");
+    failures++;
+  }
+  double nan_q[] = {0.5, NAN};
+  if (overflow_quantiles(keys, 1000, nan_q, 2, 4, 0, keys + 1000) != -1) {
+    printf("FAIL: NaN quantile accepted\n");
+    failures++;
+  }
+  double inf_q[] = {-INFINITY, INFINITY};
+  uint32_t ends[2];
+  if (overflow_quantiles(keys, 1000, inf_q, 2, 4, OVERFLOW_QUANTILE_EXACT,
+                         ends) != 0 ||
+      ends[0] != 123456 || ends[1] != 123456) {
+    printf("FAIL: infinite quantiles not clamped\n");
+    failures++;
+  }
+
+  free(keys);
+  if (!failures)
+    printf("test_quantile: OK\n");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,242 @@
+/**
+ * @file test_runfile.c
+ * @brief Writes, maps and queries run files.
+ *
+ * For several distributions, sizes and directory resolutions, a written
+ * run file must hold the sorted keys with their payloads in stable order,
+ * and lower_bound() and range() must agree with a search over a sorted
+ * copy. Truncated or foreign files must be rejected, and a write the file
+ * size limit cuts short must fail without leaving a file behind. Threads
+ * writing one path at once must each leave a whole file.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include <dirent.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include "overflow_engine.h"
+#include "overflow_runfile.h"
+
+#define SIZE 100000
+#define QUERIES 2000
+#define WRITERS 4
+
+static uint32_t keys[SIZE], payloads[SIZE], sorted[SIZE];
+
+static uint32_t random_u32(void) {
+  return ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+}
+
+static uint32_t random_key(int dist) {
+  uint32_t r = random_u32();
+  switch (dist) {
+  case 0:
+    return r; // Full range
+  case 1:
+    return r % 300; // Runs of duplicates, small bins only
+  default:
+    return r >> (r % 32); // Every tick
+  }
+}
+
+static size_t lower_bound(size_t n, uint32_t key) {
+  size_t lo = 0, hi = n;
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    if (sorted[mid] < key)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+static int check(const char *path, int dist, size_t n, unsigned sub_bits,
+                 int with_payloads) {
+  for (size_t i = 0; i < n; ++i) {
+    keys[i] = sorted[i] = random_key(dist);
+    payloads[i] = (uint32_t)i;
+  }
+  overflow_sort_u32(sorted, n);
+
+  if (overflow_runfile_write(path, keys, with_payloads ? payloads : NULL, n,
+                             sub_bits) != 0) {
+    printf("FAIL: dist %d n=%zu sub_bits %u write\n", dist, n, sub_bits);
+    return 1;
+  }
+  overflow_runfile *rf = overflow_runfile_open(path);
+  if (!rf || overflow_runfile_size(rf) != n ||
+      memcmp(overflow_runfile_keys(rf), sorted, n * sizeof(uint32_t)) != 0 ||
+      (overflow_runfile_payloads(rf) != NULL) != with_payloads) {
+    printf("FAIL: dist %d n=%zu sub_bits %u contents\n", dist, n, sub_bits);
+    overflow_runfile_close(rf);
+    return 1;
+  }
+
+  // Payloads travel with their keys, equal keys in input order
+  const uint32_t *pay = overflow_runfile_payloads(rf);
+  for (size_t i = 0; pay && i < n; ++i) {
+    if (keys[pay[i]] != sorted[i] ||
+        (i && sorted[i] == sorted[i - 1] && pay[i] <= pay[i - 1])) {
+      printf("FAIL: dist %d n=%zu payload %zu\n", dist, n, i);
+      overflow_runfile_close(rf);
+      return 1;
+    }
+  }
+
+  int failures = 0;
+  for (int q = 0; q < QUERIES && !failures; ++q) {
+    uint32_t key = q == 0   ? 0
+                   : q == 1 ? UINT32_MAX
+                   : n && q % 2 ? sorted[(size_t)rand() % n] + q % 3 - 1
+                                : random_key(dist);
+    uint32_t hi = key + random_key(dist) % 1000;
+    size_t first, count = overflow_runfile_range(rf, key, hi, &first);
+    size_t want_first = lower_bound(n, key);
+    size_t want_count = hi < key ? 0
+                        : hi == UINT32_MAX
+                            ? n - want_first
+                            : lower_bound(n, hi + 1) - want_first;
+
+    if (overflow_runfile_lower_bound(rf, key) != want_first ||
+        first != want_first || count != want_count) {
+      printf("FAIL: dist %d n=%zu sub_bits %u query [%u, %u]\n", dist, n,
+             sub_bits, key, hi);
+      failures++;
+    }
+  }
+  overflow_runfile_close(rf);
+  return failures;
+}
+
+typedef struct {
+  const char *path;
+  uint32_t key; // Every key of this writer's file
+  int rc;
+} Writer;
+
+static void *write_worker(void *arg) {
+  Writer *w = arg;
+  uint32_t same[1000];
+  for (size_t i = 0; i < 1000; ++i)
+    same[i] = w->key;
+  w->rc = overflow_runfile_write(w->path, same, NULL, 1000, 8);
+  return NULL;
+}
+
+// Concurrent writers of one path: each succeeds, the survivor is one
+// writer's whole file and no temporary file is left in dir.
+static int check_writers(const char *dir) {
+  char path[64];
+  pthread_t threads[WRITERS];
+  Writer writers[WRITERS];
+  int failures = 0;
+
+  snprintf(path, sizeof(path), "%s/shared", dir);
+  for (int t = 0; t < WRITERS; ++t) {
+    writers[t] = (Writer){path, (uint32_t)t * 1000003u, -1};
+    pthread_create(&threads[t], NULL, write_worker, &writers[t]);
+  }
+  for (int t = 0; t < WRITERS; ++t) {
+    pthread_join(threads[t], NULL);
+    failures += writers[t].rc != 0;
+  }
+
+  overflow_runfile *rf = overflow_runfile_open(path);
+  const uint32_t *got = rf ? overflow_runfile_keys(rf) : NULL;
+  int whole = rf && overflow_runfile_size(rf) == 1000 &&
+              got[0] % 1000003u == 0 && got[0] / 1000003u < WRITERS;
+  for (size_t i = 1; whole && i < 1000; ++i)
+    whole = got[i] == got[0];
+  overflow_runfile_close(rf);
+  failures += !whole;
+
+  DIR *d = opendir(dir);
+  struct dirent *e;
+  while (d && (e = readdir(d)))
+    failures += strncmp(e->d_name, "shared.", 7) == 0;
+  if (d)
+    closedir(d);
+  if (failures)
+    printf("FAIL: concurrent writers of one path\n");
+  return failures;
+}
+
+int main(void) {
+  static const size_t sizes[] = {0, 1, 47, 1000, SIZE};
+  static const unsigned sub_bits[] = {0, 4, OVERFLOW_RUNFILE_SUB_BITS, 30};
+  char dir[] = "/tmp/overflow_runfile_XXXXXX";
+  char path[64];
+  int failures = 0;
+
+  if (!mkdtemp(dir)) {
+    printf("FAIL: mkdtemp\n");
+    return 1;
+  }
+  snprintf(path, sizeof(path), "%s/runs", dir);
+
+  srand(50);
+  for (int dist = 0; dist < 3; ++dist)
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+      for (size_t s = 0; s < sizeof(sub_bits) / sizeof(sub_bits[0]); ++s)
+        for (int with_payloads = 0; with_payloads < 2; ++with_payloads)
+          failures += check(path, dist, sizes[i], sub_bits[s], with_payloads);
+
+  failures += check_writers(dir);
+
+  // A truncated file and one that is not a run file are rejected
+  FILE *f = fopen(path, "r+");
+  if (!f || ftruncate(fileno(f), 100) != 0 ||
+      overflow_runfile_open(path) != NULL) {
+    printf("FAIL: opened a truncated run file\n");
+    failures++;
+  }
+  if (f) {
+    fputs("not a run file", f);
+    fclose(f);
+  }
+  if (overflow_runfile_open(path) != NULL) {
+    printf("FAIL: opened a foreign file\n");
+    failures++;
+  }
+  snprintf(path, sizeof(path), "%s/missing/runs", dir);
+  if (overflow_runfile_write(path, keys, NULL, 10, 8) != -1 ||
+      overflow_runfile_open(path) != NULL) {
+    printf("FAIL: wrote or opened a path in a missing directory\n");
+    failures++;
+  }
+
+  // A file that can't grow to full size fails the write cleanly instead
+  // of faulting once the mapping is filled
+  struct rlimit old, small = {4096, 4096};
+  snprintf(path, sizeof(path), "%s/big", dir);
+  signal(SIGXFSZ, SIG_IGN);
+  getrlimit(RLIMIT_FSIZE, &old);
+  small.rlim_max = old.rlim_max;
+  setrlimit(RLIMIT_FSIZE, &small);
+  int rc = overflow_runfile_write(path, keys, NULL, SIZE, 8);
+  setrlimit(RLIMIT_FSIZE, &old);
+  if (rc != -1 || access(path, F_OK) == 0) {
+    printf("FAIL: wrote a run file past the file size limit\n");
+    failures++;
+  }
+
+  char cmd[64];
+  snprintf(cmd, sizeof(cmd), "rm -rf %s", dir);
+  if (system(cmd) != 0)
+    failures++;
+
+  if (!failures)
+    printf("test_runfile: OK\n");
+  return failures ? 1 : 0;
+}
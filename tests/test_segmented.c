@@ -0,0 +1,69 @@
+/**
+ * @file test_segmented.c
+ * @brief Checks overflow_sort_segmented() against qsort per segment.
+ *
+ * Covers every size class: empty, network-sized, medium tick sorts and a
+ * segment large enough to take the parallel path.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "overflow_segmented.h"
+
+int cmp_uint32(const void *a, const void *b) {
+  uint32_t ua = *(const uint32_t *)a;
+  uint32_t ub = *(const uint32_t *)b;
+  return (ua > ub) - (ua < ub);
+}
+
+int main() {
+  size_t lens[] = {0, 1, 2, 3, 5, 8, 13, 16, 17, 47, 48, 49, 1000, 70000,
+                   OVERFLOW_SEGMENT_LARGE + 12345, 7, 0, 300};
+  size_t nsegs = sizeof(lens) / sizeof(lens[0]);
+  size_t *offsets = malloc(sizeof(size_t) * (nsegs + 1));
+
+  offsets[0] = 0;
+  for (size_t s = 0; s < nsegs; ++s)
+    offsets[s + 1] = offsets[s] + lens[s];
+
+  size_t total = offsets[nsegs];
+  uint32_t *keys = malloc(sizeof(uint32_t) * total);
+  uint32_t *expect = malloc(sizeof(uint32_t) * total);
+
+  srand(12345);
+  for (size_t i = 0; i < total; ++i) {
+    // Mix full-range keys with duplicates and small magnitudes
+    uint32_t r = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+    keys[i] = (i % 3 == 0) ? r : (i % 3 == 1) ? r % 1000 : r >> (r % 32);
+  }
+  memcpy(expect, keys, sizeof(uint32_t) * total);
+  for (size_t s = 0; s < nsegs; ++s)
+    qsort(&expect[offsets[s]], lens[s], sizeof(uint32_t), cmp_uint32);
+
+  int failures = 0;
+  for (unsigned threads = 1; threads <= 4; threads *= 2) {
+    uint32_t *work = malloc(sizeof(uint32_t) * total);
+    memcpy(work, keys, sizeof(uint32_t) * total);
+    if (overflow_sort_segmented_threads(work, offsets, nsegs, threads) != 0 ||
+        memcmp(work, expect, sizeof(uint32_t) * total) != 0) {
+      printf("FAIL: segmented sort with %u threads\n", threads);
+      failures++;
+    }
+    free(work);
+  }
+
+  if (!failures)
+    printf("test_segmented: OK\n");
+
+  free(offsets);
+  free(keys);
+  free(expect);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file test_stream.c
+ * @brief Checks streaming ingest against qsort, including input from a pipe.
+ *
+ * Keys are written to a temporary file and fed back through a pipe by a
+ * child process in odd-sized writes, so reads end mid-key and chunk
+ * boundaries fall anywhere. The push API is checked with chunks smaller
+ * than the input buffer, and every stream is reused after finishing.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "overflow_stream.h"
+
+#define PIPE_WRITE 4093 // Bytes per write; not a multiple of the key size
+
+int cmp_uint32(const void *a, const void *b) {
+  uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+  return (x > y) - (x < y);
+}
+
+// Streams the file through a pipe written by a child process.
+static int sort_through_pipe(overflow_stream *s, FILE *file) {
+  int fds[2];
+  if (pipe(fds) != 0)
+    return -1;
+
+  pid_t pid = fork();
+  if (pid == 0) {
+    char block[PIPE_WRITE];
+    size_t got;
+    close(fds[0]);
+    rewind(file);
+    while ((got = fread(block, 1, sizeof(block), file)) > 0)
+      if (write(fds[1], block, got) != (ssize_t)got)
+        _exit(1);
+    _exit(0);
+  }
+
+  close(fds[1]);
+  int rc = pid < 0 ? -1 : overflow_stream_read_fd(s, fds[0]);
+  close(fds[0]);
+  int status = 0;
+  if (pid > 0)
+    waitpid(pid, &status, 0);
+  return rc == 0 && status == 0 ? 0 : -1;
+}
+
+int main() {
+  size_t sizes[] = {0, 1, 17, 1000, 65537, 1000003};
+  size_t chunks[] = {1000, 0};
+  int failures = 0;
+
+  srand(37);
+  for (size_t c = 0; c < sizeof(chunks) / sizeof(chunks[0]); ++c) {
+    overflow_stream *s = overflow_stream_create(chunks[c]);
+
+    for (size_t z = 0; z < sizeof(sizes) / sizeof(sizes[0]); ++z) {
+      size_t n = sizes[z];
+      uint32_t *keys = malloc(sizeof(uint32_t) * (n + 1));
+      uint32_t *expect = malloc(sizeof(uint32_t) * (n + 1));
+      uint32_t *out = malloc(sizeof(uint32_t) * (n + 1));
+
+      for (size_t i = 0; i < n; ++i) {
+        uint32_t r = (uint32_t)rand() * 2654435761u;
+        keys[i] = i % 3 ? r >> (r & 31) : r; // Spread over every tick
+      }
+      memcpy(expect, keys, sizeof(uint32_t) * n);
+      qsort(expect, n, sizeof(uint32_t), cmp_uint32);
+
+      FILE *file = tmpfile();
+      fwrite(keys, sizeof(uint32_t), n, file);
+      fflush(file);
+      int ok = sort_through_pipe(s, file) == 0 &&
+               overflow_stream_count(s) == n &&
+               overflow_stream_finish(s, out) == 0 &&
+               memcmp(out, expect, sizeof(uint32_t) * n) == 0;
+      fclose(file);
+      if (!ok) {
+        printf("FAIL: pipe n=%zu chunk=%zu\n", n, chunks[c]);
+        failures++;
+      }
+
+      // Uneven pushes into the same, now empty, stream
+      ok = 1;
+      for (size_t i = 0; ok && i < n; i += 777)
+        ok = overflow_stream_push(s, keys + i, n - i < 777 ? n - i : 777) == 0;
+      memset(out, 0, sizeof(uint32_t) * n);
+      ok = ok && overflow_stream_finish(s, out) == 0 &&
+           memcmp(out, expect, sizeof(uint32_t) * n) == 0;
+      if (!ok) {
+        printf("FAIL: push n=%zu chunk=%zu\n", n, chunks[c]);
+        failures++;
+      }
+
+      free(keys);
+      free(expect);
+      free(out);
+    }
+    overflow_stream_destroy(s);
+  }
+
+  if (!failures)
+    printf("test_stream: OK\n");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,56 @@
+/**
+ * @file test_u16.c
+ * @brief Checks the two-level uint16_t counting sort against qsort.
+ *
+ * Full-range keys, keys confined to one high byte (the single-slice path)
+ * and sizes around the insertion-sort cutoff.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "overflow_u16.h"
+
+int cmp_uint16(const void *a, const void *b) {
+  return (int)*(const uint16_t *)a - (int)*(const uint16_t *)b;
+}
+
+int main() {
+  size_t sizes[] = {0, 1, 2, 47, 48, 49, 50, 1000, 65536, 1000003};
+  int failures = 0;
+
+  srand(99);
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+    size_t n = sizes[s];
+    uint16_t *keys = malloc(sizeof(uint16_t) * (n + 1));
+    uint16_t *expect = malloc(sizeof(uint16_t) * (n + 1));
+
+    for (int dist = 0; dist < 3; ++dist) {
+      for (size_t i = 0; i < n; ++i) {
+        uint16_t r = (uint16_t)rand();
+        // Full range, one high byte, and a few heavy duplicates
+        keys[i] = dist == 0 ? r : dist == 1 ? 0x3400 | (r & 0xff) : r % 5;
+      }
+      memcpy(expect, keys, sizeof(uint16_t) * n);
+      qsort(expect, n, sizeof(uint16_t), cmp_uint16);
+
+      if (overflow_sort_u16(keys, n) != 0 ||
+          memcmp(keys, expect, sizeof(uint16_t) * n) != 0) {
+        printf("FAIL: overflow_sort_u16 n=%zu dist=%d\n", n, dist);
+        failures++;
+      }
+    }
+    free(keys);
+    free(expect);
+  }
+
+  if (!failures)
+    printf("test_u16: OK\n");
+  return failures ? 1 : 0;
+}
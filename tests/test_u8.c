@@ -0,0 +1,74 @@
+/**
+ * @file test_u8.c
+ * @brief Checks the byte-key engine against a reference counting sort.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "overflow_tick.h"
+#include "overflow_u8.h"
+
+static void reference(const uint8_t *in, size_t n, uint8_t *out,
+                      int ticks_only) {
+  size_t counts[256] = {0};
+  size_t k = 0;
+  for (size_t i = 0; i < n; ++i)
+    counts[ticks_only ? overflow_tick_u32(in[i]) : in[i]]++;
+  for (int v = 0; v < 256; ++v)
+    for (size_t c = 0; c < counts[v]; ++c)
+      out[k++] = (uint8_t)v;
+}
+
+int main() {
+  size_t sizes[] = {0, 1, 7, 8, 9, 1000, 3 * OVERFLOW_U8_PARALLEL_MIN + 5};
+  size_t max = sizes[sizeof(sizes) / sizeof(sizes[0]) - 1];
+  uint8_t *input = malloc(max);
+  uint8_t *expect = malloc(max);
+  uint8_t *work = malloc(max);
+  int failures = 0;
+
+  srand(7);
+  for (size_t i = 0; i < max; ++i) {
+    // Skewed: long runs of a few values mixed with uniform bytes
+    input[i] = (i / 4096) % 3 == 0 ? (uint8_t)(i / 4096) : (uint8_t)rand();
+  }
+
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+    size_t n = sizes[s];
+    for (int ticks_only = 0; ticks_only <= 1; ++ticks_only) {
+      unsigned flags = ticks_only ? OVERFLOW_U8_TICKS_ONLY : 0;
+      reference(input, n, expect, ticks_only);
+
+      memcpy(work, input, n);
+      overflow_sort_u8(work, n, flags);
+      if (memcmp(work, expect, n) != 0) {
+        printf("FAIL: overflow_sort_u8 n=%zu flags=%u\n", n, flags);
+        failures++;
+      }
+
+      for (unsigned threads = 2; threads <= 4; threads += 2) {
+        memcpy(work, input, n);
+        overflow_sort_u8_threads(work, n, threads, flags);
+        if (memcmp(work, expect, n) != 0) {
+          printf("FAIL: overflow_sort_u8_threads n=%zu threads=%u flags=%u\n",
+                 n, threads, flags);
+          failures++;
+        }
+      }
+    }
+  }
+
+  free(input);
+  free(expect);
+  free(work);
+  if (!failures)
+    printf("test_u8: OK\n");
+  return failures ? 1 : 0;
+}
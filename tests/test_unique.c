@@ -0,0 +1,105 @@
+/**
+ * @file test_unique.c
+ * @brief Checks distinct keys, counts and payload sums against qsort.
+ *
+ * Distributions cover all-dense input (few small keys), all-spilled input
+ * (sparse full-range keys) and mixtures where both meet in one output.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "overflow_unique.h"
+
+typedef struct {
+  uint32_t key, payload;
+} Pair;
+
+int cmp_pair(const void *a, const void *b) {
+  uint32_t x = ((const Pair *)a)->key, y = ((const Pair *)b)->key;
+  return (x > y) - (x < y);
+}
+
+int main() {
+  size_t sizes[] = {0, 1, 2, 100, 5000, 1000003};
+  int failures = 0;
+
+  srand(39);
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+    size_t n = sizes[s];
+    uint32_t *keys = malloc(sizeof(uint32_t) * (n + 1));
+    uint32_t *payload = malloc(sizeof(uint32_t) * (n + 1));
+    Pair *pairs = malloc(sizeof(Pair) * (n + 1));
+    uint32_t *out = malloc(sizeof(uint32_t) * (n + 1));
+    uint32_t *expect = malloc(sizeof(uint32_t) * (n + 1));
+    uint64_t *counts = malloc(sizeof(uint64_t) * (n + 1));
+    uint64_t *ecounts = malloc(sizeof(uint64_t) * (n + 1));
+    uint64_t *sums = malloc(sizeof(uint64_t) * (n + 1));
+    uint64_t *esums = malloc(sizeof(uint64_t) * (n + 1));
+
+    for (int dist = 0; dist < 4; ++dist) {
+      for (size_t i = 0; i < n; ++i) {
+        uint32_t r = (uint32_t)rand() * 2654435761u;
+        // 256 small keys, full range, mixed widths, values around 2^16
+        keys[i] = dist == 0   ? r % 256
+                  : dist == 1 ? r
+                  : dist == 2 ? (i % 2 ? r % 3000 : r >> (r & 31))
+                              : 65000 + r % 1000;
+        payload[i] = (uint32_t)rand();
+        pairs[i] = (Pair){keys[i], payload[i]};
+      }
+
+      // Oracle: sort the pairs and run-length merge
+      qsort(pairs, n, sizeof(Pair), cmp_pair);
+      size_t ed = 0;
+      for (size_t i = 0; i < n; ++ed) {
+        expect[ed] = pairs[i].key;
+        ecounts[ed] = esums[ed] = 0;
+        for (; i < n && pairs[i].key == expect[ed]; ++i) {
+          ecounts[ed]++;
+          esums[ed] += pairs[i].payload;
+        }
+      }
+
+      size_t d = (size_t)-1;
+      int ok = overflow_sort_unique(keys, n, out, &d) == 0 && d == ed &&
+               memcmp(out, expect, sizeof(uint32_t) * d) == 0;
+      if (!ok) {
+        printf("FAIL: overflow_sort_unique n=%zu dist=%d\n", n, dist);
+        failures++;
+      }
+
+      d = (size_t)-1;
+      ok = overflow_count_distinct_sorted(keys, payload, n, out, counts, sums,
+                                          &d) == 0 &&
+           d == ed && memcmp(out, expect, sizeof(uint32_t) * d) == 0 &&
+           memcmp(counts, ecounts, sizeof(uint64_t) * d) == 0 &&
+           memcmp(sums, esums, sizeof(uint64_t) * d) == 0;
+      if (!ok) {
+        printf("FAIL: overflow_count_distinct_sorted n=%zu dist=%d\n", n,
+               dist);
+        failures++;
+      }
+    }
+
+    free(keys);
+    free(payload);
+    free(pairs);
+    free(out);
+    free(expect);
+    free(counts);
+    free(ecounts);
+    free(sums);
+    free(esums);
+  }
+
+  if (!failures)
+    printf("test_unique: OK\n");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,158 @@
+/**
+ * @file test_vec.c
+ * @brief Compares every vector backend with the scalar reference.
+ *
+ * Lengths are chosen to hit full vectors and every tail size; keys cover
+ * zero, each power of two and its neighbours, and random values.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "overflow_tick.h"
+#include "overflow_vec.h"
+
+#define SIZE 5000
+
+static uint32_t edge_or_random(size_t i) {
+  uint32_t r = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+  if (i % 4 == 0) {
+    uint32_t p = 1u << (r % 32);
+    return p + (uint32_t)(r % 3) - 1; // 2^k - 1, 2^k, 2^k + 1
+  }
+  return i % 4 == 1 ? 0 : r >> (r % 32);
+}
+
+int main() {
+  static uint32_t k32[SIZE];
+  static uint16_t k16[SIZE];
+  static uint8_t k8[SIZE];
+  static uint8_t want[SIZE], got[SIZE];
+  const overflow_vec_ops *ref = overflow_vec_backend(OVERFLOW_VEC_SCALAR);
+  int failures = 0;
+
+  srand(2024);
+  for (size_t i = 0; i < SIZE; ++i) {
+    k32[i] = edge_or_random(i);
+    k16[i] = (uint16_t)(k32[i] >> (i % 17));
+    k8[i] = (uint8_t)(k32[i] >> (i % 25));
+  }
+
+  for (int b = 0; b < OVERFLOW_VEC_BACKENDS; ++b) {
+    const overflow_vec_ops *ops = overflow_vec_backend(b);
+    if (!ops) {
+      printf("test_vec: backend %d not supported here, skipped\n", b);
+      continue;
+    }
+
+    // Offsets shift alignment, lengths cover every tail
+    for (size_t off = 0; off < 3; ++off) {
+      for (size_t n = 0; n < 140; n += (n < 70 ? 1 : 13)) {
+        ref->ticks_u32(&k32[off], n, want);
+        ops->ticks_u32(&k32[off], n, got);
+        if (memcmp(want, got, n) != 0) {
+          printf("FAIL: %s ticks_u32 n=%zu off=%zu\n", ops->name, n, off);
+          failures++;
+        }
+        ref->ticks_u16(&k16[off], n, want);
+        ops->ticks_u16(&k16[off], n, got);
+        if (memcmp(want, got, n) != 0) {
+          printf("FAIL: %s ticks_u16 n=%zu off=%zu\n", ops->name, n, off);
+          failures++;
+        }
+        ref->ticks_u8(&k8[off], n, want);
+        ops->ticks_u8(&k8[off], n, got);
+        if (memcmp(want, got, n) != 0) {
+          printf("FAIL: %s ticks_u8 n=%zu off=%zu\n", ops->name, n, off);
+          failures++;
+        }
+      }
+    }
+
+    static uint16_t bins_want[SIZE], bins_got[SIZE];
+    for (unsigned sub = 0; sub <= OVERFLOW_LOGLIN_SUB_MAX; ++sub) {
+      for (size_t n = 0; n < 140; n += (n < 70 ? 1 : 13)) {
+        ref->loglin_u32(&k32[1], n, sub, bins_want);
+        ops->loglin_u32(&k32[1], n, sub, bins_got);
+        if (memcmp(bins_want, bins_got, n * sizeof(uint16_t)) != 0) {
+          printf("FAIL: %s loglin_u32 n=%zu sub=%u\n", ops->name, n, sub);
+          failures++;
+        }
+      }
+    }
+
+    for (size_t n = 0; n < 140; n += (n < 70 ? 1 : 13)) {
+      uint32_t v = k32[n * 31 % SIZE];
+      if (ref->count_below_u32(&k32[2], n, v) !=
+              ops->count_below_u32(&k32[2], n, v) ||
+          ops->count_below_u32(k32, SIZE, v) !=
+              ref->count_below_u32(k32, SIZE, v)) {
+        printf("FAIL: %s count_below_u32 n=%zu v=%u\n", ops->name, n, v);
+        failures++;
+      }
+      if (ref->min_u32(&k32[3], n) != ops->min_u32(&k32[3], n)) {
+        printf("FAIL: %s min_u32 n=%zu\n", ops->name, n);
+        failures++;
+      }
+      uint32_t lo_want, hi_want, lo_got, hi_got;
+      ref->minmax_u32(&k32[3], n, &lo_want, &hi_want);
+      ops->minmax_u32(&k32[3], n, &lo_got, &hi_got);
+      if (lo_want != lo_got || hi_want != hi_got) {
+        printf("FAIL: %s minmax_u32 n=%zu\n", ops->name, n);
+        failures++;
+      }
+    }
+
+    size_t hist_want[OVERFLOW_TICKS_U32], hist_got[OVERFLOW_TICKS_U32];
+    ref->histogram_u32(k32, SIZE, hist_want);
+    ops->histogram_u32(k32, SIZE, hist_got);
+    if (memcmp(hist_want, hist_got, sizeof(hist_want)) != 0) {
+      printf("FAIL: %s histogram_u32\n", ops->name);
+      failures++;
+    }
+    uint32_t lo_want, hi_want, lo_got, hi_got;
+    ref->histogram_minmax_u32(&k32[1], SIZE - 1, hist_want, &lo_want,
+                              &hi_want);
+    ops->histogram_minmax_u32(&k32[1], SIZE - 1, hist_got, &lo_got, &hi_got);
+    if (memcmp(hist_want, hist_got, sizeof(hist_want)) != 0 ||
+        lo_want != lo_got || hi_want != hi_got) {
+      printf("FAIL: %s histogram_minmax_u32\n", ops->name);
+      failures++;
+    }
+  }
+
+  // Log-linear bins refine ticks, grow with the key and stay in range
+  for (unsigned sub = 0; sub <= OVERFLOW_LOGLIN_SUB_MAX; ++sub) {
+    for (size_t i = 0; i < SIZE; ++i) {
+      uint32_t v = k32[i], w = v + 1 ? v + 1 : v;
+      unsigned b = overflow_loglin_u32(v, sub);
+      if ((sub == 0 && b != overflow_tick_u32(v)) ||
+          overflow_loglin_u32(w, sub) < b ||
+          b >= OVERFLOW_LOGLIN_BINS_U32(sub)) {
+        printf("FAIL: overflow_loglin_u32 v=%u sub=%u\n", v, sub);
+        failures++;
+        break;
+      }
+    }
+  }
+
+  // The scalar reference itself must agree with overflow_tick_u32()
+  ref->ticks_u32(k32, SIZE, got);
+  for (size_t i = 0; i < SIZE; ++i) {
+    if (got[i] != overflow_tick_u32(k32[i])) {
+      printf("FAIL: scalar reference at %zu\n", i);
+      failures++;
+      break;
+    }
+  }
+
+  if (!failures)
+    printf("test_vec: OK (best backend: %s)\n", overflow_vec_best()->name);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,91 @@
+/**
+ * @file test_window.c
+ * @brief Checks windowed sorting against qsort, window by window.
+ *
+ * Windows of varying size, including empty ones, are pushed in uneven
+ * batches; each emitted window must be the next one in order and match
+ * its keys sorted by qsort.
+ *
+ * @author Scott Douglass
+ * @date 2026-10-18
+ * @license MIT
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "overflow_window.h"
+
+#define WINDOWS 24
+
+typedef struct {
+  uint32_t *input[WINDOWS];
+  uint32_t *expect[WINDOWS];
+  size_t n[WINDOWS];
+  uint64_t next; // Window expected next
+  int failures;
+} Check;
+
+int cmp_uint32(const void *a, const void *b) {
+  uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+  return (x > y) - (x < y);
+}
+
+static void check_window(void *arg, uint64_t window, const uint32_t *keys,
+                         size_t n) {
+  Check *c = arg;
+  if (window != c->next++ || n != c->n[window] ||
+      memcmp(keys, c->expect[window], sizeof(uint32_t) * n) != 0) {
+    printf("FAIL: window %llu n=%zu\n", (unsigned long long)window, n);
+    c->failures++;
+  }
+}
+
+int main() {
+  Check check = {0};
+  size_t chunks[] = {1000, 0};
+
+  srand(38);
+  for (size_t w = 0; w < WINDOWS; ++w) {
+    size_t n = w % 7 == 3 ? 0 : (size_t)rand() % (w % 2 ? 300000 : 5000);
+    check.n[w] = n;
+    check.input[w] = malloc(sizeof(uint32_t) * (n + 1));
+    check.expect[w] = malloc(sizeof(uint32_t) * (n + 1));
+    for (size_t i = 0; i < n; ++i) {
+      uint32_t r = (uint32_t)rand() * 2654435761u;
+      check.input[w][i] = i % 3 ? r >> (r & 31) : r;
+    }
+    memcpy(check.expect[w], check.input[w], sizeof(uint32_t) * n);
+    qsort(check.expect[w], n, sizeof(uint32_t), cmp_uint32);
+  }
+
+  for (size_t c = 0; c < sizeof(chunks) / sizeof(chunks[0]); ++c) {
+    overflow_window *win = overflow_window_create(check_window, &check,
+                                                  chunks[c]);
+    check.next = 0;
+    for (size_t w = 0; w < WINDOWS; ++w) {
+      for (size_t i = 0; i < check.n[w]; i += 4099) {
+        size_t take = check.n[w] - i < 4099 ? check.n[w] - i : 4099;
+        if (overflow_window_push(win, check.input[w] + i, take) != 0)
+          check.failures++;
+      }
+      if (overflow_window_close(win) != 0)
+        check.failures++;
+    }
+    if (overflow_window_flush(win) != 0 || check.next != WINDOWS) {
+      printf("FAIL: flush chunk=%zu\n", chunks[c]);
+      check.failures++;
+    }
+    overflow_window_destroy(win);
+  }
+
+  for (size_t w = 0; w < WINDOWS; ++w) {
+    free(check.input[w]);
+    free(check.expect[w]);
+  }
+  if (!check.failures)
+    printf("test_window: OK\n");
+  return check.failures ? 1 : 0;
+}